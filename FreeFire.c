@@ -4,35 +4,450 @@
  * Módulo de priorização e montagem da torre de fuga
  *
  * Funcionalidades:
- *  - Cadastro de até 20 componentes (nome, tipo, prioridade)
+ *  - Cadastro de componentes (nome, tipo, prioridade) em vetor dinâmico no heap
  *  - Bubble sort por nome (alfabético crescente) com contagem de comparações e tempo
+ *  - Merge sort por nome (O(n log n), estável) para inventários grandes
+ *  - Merge sort paralelo por nome (pthreads): blocos ordenados em paralelo e intercalados
+ *    em rodadas nas quais todas as threads escrevem fatias iguais da saída
+ *  - Bucket sort paralelo por tipo e por prioridade: histogramas por thread e distribuição
+ *    simultânea em regiões exclusivas de cada balde (estável, O(n + k))
+ *  - Ordenação composta por várias chaves (ordem e sentido escolhidos, ex.: tipo crescente,
+ *    prioridade decrescente, nome crescente) em um único merge sort estável sobre chaves
+ *    empacotadas em 64 bits, desempatando pelo nome completo só quando necessário
  *  - Insertion sort por tipo (alfabético crescente) com contagem de comparações e tempo
  *  - Selection sort por prioridade (decrescente: maior prioridade primeiro) com contagem de comparações e tempo
+ *  - Counting sort por prioridade (decrescente, estável, O(n + k))
+ *  - Top-K por prioridade: os K componentes mais prioritários via heap, O(n log K),
+ *    sem ordenar o inventário inteiro
+ *  - Fila de prioridade por baldes (um por prioridade) para a montagem da torre:
+ *    inserir, retirar o mais prioritário e remover/alterar em O(1)
+ *  - Modo de ordenação por índices: as ordenações permutam visões de índices de 32 bits
+ *    e os registros ficam no lugar (nome, tipo e prioridade coexistem como visões)
+ *  - Inventário com visões ordenadas persistentes (nome, tipo, prioridade): a busca
+ *    binária usa sempre a visão por nome, que ordenar por outro critério não invalida
  *  - Busca binária por nome (após ordenação por nome) com contagem de comparações
+ *  - Busca em lote: as consultas são ordenadas e resolvidas em uma só varredura com
+ *    galope sobre a visão por nome, com comparações agregadas e vazão
+ *  - Busca por prefixo (autocompletar): limites inferior e superior na visão por nome
+ *    dão o intervalo contíguo de nomes com aquele início, exibido até um limite
+ *  - Inserção ordenada: cada componente cadastrado entra na sua posição da visão por
+ *    nome (busca binária + deslocamento de bloco), que continua válida para a busca
+ *  - Índice hash (endereçamento aberto) por nome case-insensitive, mantido a cada inserção,
+ *    com contagem de sondagens
+ *  - Carga em lote de arquivos CSV/TSV (nome, tipo, prioridade) com uma única leitura
+ *  - Formato binário versionado do inventário (registros + visões ordenadas) aberto
+ *    via mmap e usado diretamente, sem reanálise nem reordenação
+ *  - Contadores de hardware opcionais (Linux, perf_event_open): ciclos, instruções,
+ *    falhas de desvio, falhas L1d e LLC ao redor de ordenações e buscas
+ *  - Espelho opcional em colunas (SoA: nome, tipo e prioridade em vetores separados) usado
+ *    por visões, buscas e exibição para ler só os campos necessários; os registros
+ *    continuam sendo a cópia principal, então ligar as colunas dobra a memória dos dados
+ *  - Dicionário de tipos: cada tipo distinto vira um ID inteiro na inserção; ordenar por
+ *    tipo compara ranks (ordem alfabética do dicionário) e o texto só é lido para exibição
  *  - Menu interativo e exibição de métricas
+ *  - Modo em lote (sem prompts): comandos via -c "cmd; cmd" ou --script arquivo
+ *  - Benchmark de todas as ordenações sobre dados sintéticos (várias distribuições,
+ *    n de 10 a 10^7), com saída CSV de comparações, movimentos, tempo e ciclos
+ *
+ * Compilação: gcc -O2 -pthread FreeFire.c -o freefire
+ *
+ * Uso:
+ *  - ./freefire                      menu interativo
+ *  - ./freefire -c "carregar inv.csv; ordenar nome; buscar Chip"
+ *  - ./freefire --script comandos.txt  (use '-' para ler os comandos da entrada padrão)
+ *  - ./freefire --bench [saida.csv] [n_max] [repeticoes]
  *
  * Observações:
  *  - Usa fgets para captura segura de strings
- *  - Utiliza clock() para medir tempo de execução
+ *  - Mede tempo com relógio monotônico de alta resolução; o comando/opção "medir"
+ *    repete a operação N vezes sobre cópias novas e reporta mín/mediana/p99/média
  *  - Implementa comparação de strings case-insensitive local (stricmp)
+ *  - Cada componente guarda o nome já em minúsculas (chave calculada na inserção);
+ *    ordenações e buscas comparam essas chaves com memcmp, sem tolower por comparação
+ *  - As chaves têm 32 bytes e são comparadas/convertidas por kernels SSE2/AVX2 escolhidos
+ *    em tempo de execução, com versão escalar de reserva (FREEFIRE_SIMD força uma delas)
+ *  - Cada chave também guarda seus 8 primeiros bytes como inteiro big-endian: a maioria
+ *    das comparações se resolve com uma comparação de 64 bits, sem tocar a chave completa
  */
 
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE /* syscall() para perf_event_open */
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
 #include <ctype.h>
+#include <stdint.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define USA_MMAP 1
+#define USA_PTHREAD 1 /* compilar com -pthread */
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
-#define MAX_COMPONENTES 20
+#ifdef __linux__
+#define USA_PERF_EVENT 1
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define LER_CICLOS() ((unsigned long long)__rdtsc())
+#if defined(__GNUC__) && defined(__SSE2__)
+#define USA_SIMD_X86 1 /* kernels SSE2 sempre; AVX2 escolhido em tempo de execução */
+#endif
+#else
+#define LER_CICLOS() 0ULL /* sem contador de ciclos acessível */
+#endif
+
+#define CAPACIDADE_INICIAL 16
+#define HASH_CAPACIDADE_INICIAL 64 /* potência de 2 */
+#define HASH_VAZIO UINT32_MAX
+#define LIMIAR_INSERCAO 16 /* sub-vetores até este tamanho são ordenados por inserção no merge sort */
+#define LIMIAR_PARALELO 8192 /* mínimo de componentes por thread no merge sort paralelo */
+#define MAX_THREADS 256
 #define MAX_NOME 30
 #define MAX_TIPO 20
+#define TAM_CHAVE 32 /* chaves de comparação: um registrador AVX2 (>= MAX_NOME e MAX_TIPO) */
+#define NOME_PADRAO "SEM_NOME"
+#define TIPO_PADRAO "GENERIC"
+#define TIPO_ID_PADRAO 0          /* TIPO_PADRAO é o primeiro tipo do dicionário (tiposIniciar) */
+#define TIPO_INVALIDO UINT32_MAX
+#define FILA_SEM_ID UINT32_MAX    /* fim de lista / fila vazia na fila de prioridade */
+#define PRIORIDADE_MIN 1
+#define PRIORIDADE_MAX 10
+
+#define FORMATO_MAGICA "FFTORRE"   /* 7 caracteres + '\0' */
+#define FORMATO_VERSAO 5           /* incrementar a cada mudança no layout de Componente */
+#define FORMATO_MARCA_ENDIAN 0x01020304u
+#define FORMATO_ALINHAMENTO 64
+
+#define REPETICOES_PADRAO 10
+#define LIMITE_PREFIXO_PADRAO 20 /* resultados exibidos pela busca por prefixo */
+#define BENCH_N_MAX_PADRAO 10000000
+#define BENCH_LIMITE_QUADRATICO 20000 /* acima disso os algoritmos O(n^2) são pulados */
+#define BENCH_SEMENTE 0x9E3779B97F4A7C15ULL
 
 typedef struct {
     char nome[MAX_NOME];
-    char tipo[MAX_TIPO];
-    int prioridade; /* 1 (menor) .. 10 (maior) */
+    uint32_t tipoId; /* ID no dicionário de tipos (texto em tipoTexto) */
+    int prioridade;  /* 1 (menor) .. 10 (maior) */
+    /* 8 primeiros bytes de chaveNome em big-endian: decidem a maioria das comparações */
+    uint64_t prefixoNome;
+    /* chave de comparação: nome em minúsculas, completado com '\0' (ver componenteAtualizarChaves) */
+    char chaveNome[TAM_CHAVE];
 } Componente;
 
+/*
+ * Dicionário de tipos. Os tipos formam um vocabulário pequeno (controle, suporte,
+ * propulsao, GENERIC...): cada texto distinto recebe um ID na primeira vez em que
+ * aparece e os componentes guardam só o ID; o texto serve apenas para exibição.
+ * rank[id] é a posição do tipo na ordem alfabética case-insensitive (tipos que só
+ * diferem na caixa empatam), então ordenar por tipo é comparar inteiros pequenos.
+ */
+typedef struct {
+    char (*texto)[MAX_TIPO];
+    char (*chave)[TAM_CHAVE]; /* texto em minúsculas, para calcular os ranks */
+    uint32_t *rank;
+    uint32_t *ordem;          /* auxiliar do cálculo dos ranks */
+    size_t total;
+    size_t capacidade;
+    size_t totalRanks;        /* ranks distintos (0 .. totalRanks-1) */
+    int ranksValidos;         /* 0 se um tipo foi criado depois do último cálculo */
+    uint32_t *slots;          /* hash do texto exato -> ID (HASH_VAZIO = livre) */
+    size_t capacidadeSlots;   /* potência de 2, ocupação abaixo de 50% */
+} DicionarioTipos;
+
+/*
+ * Vetor dinâmico de componentes (heap).
+ * A capacidade cresce geometricamente (x2), garantindo inserção amortizada O(1);
+ * o limite passa a ser apenas a memória disponível.
+ */
+typedef struct {
+    Componente *dados;
+    size_t total;      /* componentes em uso */
+    size_t capacidade; /* componentes alocados */
+    int externo;       /* 1: dados pertencem a um arquivo mapeado (não liberar nem realocar) */
+} VetorComponentes;
+
+/* critérios de ordenação (um por visão de índices) */
+typedef enum {
+    CRITERIO_NOME,
+    CRITERIO_TIPO,
+    CRITERIO_PRIORIDADE,
+    TOTAL_CRITERIOS
+} CriterioOrdenacao;
+
+/*
+ * Visão ordenada: permutação de índices de 32 bits sobre um VetorComponentes.
+ * Ordenar uma visão move 4 bytes por elemento em vez de um Componente inteiro.
+ */
+typedef struct {
+    uint32_t *indices;
+    size_t total;
+    int externo; /* 1: índices pertencem a um arquivo mapeado */
+    size_t capacidade; /* índices alocados (heap) */
+} VisaoIndices;
+
+/*
+ * Índice hash por nome (endereçamento aberto, sondagem linear).
+ * Cada slot guarda o índice do registro em VetorComponentes ou HASH_VAZIO;
+ * a ocupação é mantida abaixo de 50% para sondagens curtas.
+ */
+typedef struct {
+    uint32_t *slots;
+    size_t capacidade; /* potência de 2 */
+    size_t ocupados;
+} IndiceHash;
+
+/*
+ * Espelho em colunas (SoA) dos componentes de VetorComponentes: cada campo fica
+ * num vetor contíguo próprio, na mesma posição que no registro. Ordenar uma
+ * visão por prioridade lê 1 byte por registro em vez de uma linha de cache;
+ * por nome, só os prefixos (8 bytes) e, em empate, as chaves. É uma segunda
+ * cópia (cerca de 2x a memória dos registros): inserções, carga e gravação
+ * continuam nos registros e as colunas são reconstruídas a partir deles.
+ */
+typedef struct {
+    char (*nome)[MAX_NOME];
+    uint32_t *tipoId;
+    uint8_t *prioridade;
+    uint64_t *prefixoNome;
+    char (*chaveNome)[TAM_CHAVE];
+    size_t total;
+    size_t capacidade;
+} ColunasComponentes;
+
+/* origem dos campos para visões, buscas e exibição: colunas, se houver, senão registros */
+typedef struct {
+    const Componente *registros;
+    const ColunasComponentes *colunas;
+} FonteComponentes;
+
+/*
+ * Ordenação composta: chaves em ordem de precedência (cada critério no máximo
+ * uma vez), cada uma com seu sentido. Ex.: tipo crescente, prioridade
+ * decrescente, nome crescente.
+ */
+typedef struct {
+    CriterioOrdenacao criterio[TOTAL_CRITERIOS];
+    int decrescente[TOTAL_CRITERIOS];
+    int total;
+} EspecificacaoOrdenacao;
+
+/*
+ * Fila de prioridade por baldes para a montagem da torre: como a prioridade vai
+ * de PRIORIDADE_MIN a PRIORIDADE_MAX, cada valor tem uma lista duplamente ligada
+ * (por ID de componente) e inserir, retirar o maior e remover/alterar são O(1).
+ * Dentro de um balde a ordem é a de chegada.
+ */
+typedef struct {
+    uint32_t cabeca[PRIORIDADE_MAX + 1]; /* FILA_SEM_ID: balde vazio */
+    uint32_t cauda[PRIORIDADE_MAX + 1];
+    uint32_t *proximo;  /* por ID */
+    uint32_t *anterior;
+    uint8_t *balde;     /* prioridade na fila; 0 = fora da fila */
+    size_t capacidade;  /* IDs endereçáveis */
+    size_t total;       /* componentes na fila */
+    int maior;          /* nenhum balde acima deste está ocupado */
+} FilaPrioridade;
+
+/*
+ * Inventário: componentes + uma visão ordenada persistente por critério.
+ * As visões são construídas sob demanda e só se tornam inválidas quando os
+ * registros mudam de posição ou são recadastrados.
+ */
+typedef struct {
+    VetorComponentes itens;
+    VisaoIndices visoes[TOTAL_CRITERIOS];
+    int visaoValida[TOTAL_CRITERIOS];
+    IndiceHash hashNome;
+    int hashValido; /* 0 se uma inserção no hash falhou por falta de memória */
+    void *mapa;           /* arquivo binário aberto (mmap), ou NULL */
+    size_t tamanhoMapa;
+    int modoColunas;      /* 1: visões, buscas e exibição usam as colunas */
+    ColunasComponentes colunas;
+    int colunasValidas;   /* 0: colunas desatualizadas (reconstruídas sob demanda) */
+    VisaoIndices visaoComposta;          /* última ordenação composta */
+    EspecificacaoOrdenacao especComposta;
+    int compostaValida;
+    FilaPrioridade montagem;  /* fila da montagem da torre (se montagemAtiva) */
+    int montagemAtiva;
+    int conferenciaPendente;  /* 1: registros e visões de um arquivo ainda não conferidos */
+} Inventario;
+
+/*
+ * Cabeçalho do formato binário do inventário. Em seguida vêm, alinhados em
+ * FORMATO_ALINHAMENTO bytes, os registros (Componente[total]), as visões
+ * válidas (uint32_t[total] cada; deslocamento 0 = visão ausente) e os textos
+ * do dicionário de tipos a que os tipoId dos registros se referem.
+ */
+typedef struct {
+    char magica[8];
+    uint32_t versao;
+    uint32_t marcaEndian;
+    uint32_t tamanhoRegistro; /* sizeof(Componente) de quem gravou */
+    uint32_t totalTipos;      /* entradas do dicionário de tipos gravado */
+    uint64_t total;
+    uint64_t deslocRegistros;
+    uint64_t deslocVisoes[TOTAL_CRITERIOS];
+    uint64_t deslocTipos;     /* char[MAX_TIPO] por tipo, na ordem dos IDs */
+} CabecalhoInventario;
+
+/* comparador de dois registros (por índice) no estilo strcmp (< 0, 0, > 0) */
+typedef int (*ComparadorIndice)(const FonteComponentes *f, uint32_t a, uint32_t b);
+
+/* ---------------- vetor dinâmico ---------------- */
+
+void vetorIniciar(VetorComponentes *v) {
+    v->dados = NULL;
+    v->total = 0;
+    v->capacidade = 0;
+    v->externo = 0;
+}
+
+void vetorLiberar(VetorComponentes *v) {
+    if (!v->externo) free(v->dados);
+    vetorIniciar(v);
+}
+
+/* substitui o buffer de dados por 'novo' (alocado no heap, com 'capacidade' posições) */
+static void vetorTrocarDados(VetorComponentes *v, Componente *novo, size_t capacidade) {
+    if (!v->externo) free(v->dados);
+    v->dados = novo;
+    v->capacidade = capacidade;
+    v->externo = 0;
+}
+
+/* descarta os componentes, mantendo a memória alocada */
+void vetorLimpar(VetorComponentes *v) {
+    v->total = 0;
+}
+
+/* garante espaço para pelo menos 'capacidade' componentes; retorna 0 em sucesso, -1 sem memória */
+int vetorReservar(VetorComponentes *v, size_t capacidade) {
+    if (capacidade <= v->capacidade) return 0;
+    if (capacidade > SIZE_MAX / sizeof(Componente)) return -1;
+    if (v->externo) {
+        /* dados mapeados não podem crescer: copia para o heap */
+        Componente *novo = malloc(capacidade * sizeof(Componente));
+        if (!novo) return -1;
+        if (v->total > 0) memcpy(novo, v->dados, v->total * sizeof(Componente));
+        vetorTrocarDados(v, novo, capacidade);
+        return 0;
+    }
+    Componente *novo = realloc(v->dados, capacidade * sizeof(Componente));
+    if (!novo) return -1;
+    v->dados = novo;
+    v->capacidade = capacidade;
+    return 0;
+}
+
+/* reduz a capacidade ao total em uso (libera a folga do crescimento geométrico) */
+int vetorAjustarCapacidade(VetorComponentes *v) {
+    if (v->total == v->capacidade || v->externo) return 0;
+    if (v->total == 0) {
+        vetorLiberar(v);
+        return 0;
+    }
+    Componente *novo = realloc(v->dados, v->total * sizeof(Componente));
+    if (!novo) return -1;
+    v->dados = novo;
+    v->capacidade = v->total;
+    return 0;
+}
+
+/* reserva uma nova posição no fim do vetor e a devolve (NULL se faltar memória) */
+Componente *vetorAdicionar(VetorComponentes *v) {
+    if (v->total == v->capacidade) {
+        size_t nova = v->capacidade ? v->capacidade * 2 : CAPACIDADE_INICIAL;
+        if (nova < v->capacidade || vetorReservar(v, nova) != 0) return NULL;
+    }
+    return &v->dados[v->total++];
+}
+
+/* ---------------- armazenamento em colunas (SoA) ---------------- */
+
+void colunasIniciar(ColunasComponentes *col) {
+    memset(col, 0, sizeof(*col));
+}
+
+void colunasLiberar(ColunasComponentes *col) {
+    free(col->nome);
+    free(col->tipoId);
+    free(col->prioridade);
+    free(col->prefixoNome);
+    free(col->chaveNome);
+    colunasIniciar(col);
+}
+
+/* realoca *p para n elementos de 'tam' bytes; mantém o bloco antigo em caso de falha */
+static int realocarColuna(void **p, size_t n, size_t tam) {
+    void *novo = realloc(*p, n * tam);
+    if (!novo) return -1;
+    *p = novo;
+    return 0;
+}
+
+/* garante capacidade para pelo menos 'minimo' linhas em todas as colunas; 0 em sucesso */
+int colunasReservar(ColunasComponentes *col, size_t minimo) {
+    if (minimo <= col->capacidade) return 0;
+    size_t nova = col->capacidade ? col->capacidade : CAPACIDADE_INICIAL;
+    while (nova < minimo) nova *= 2;
+    if (realocarColuna((void **)&col->nome, nova, sizeof(*col->nome)) != 0
+        || realocarColuna((void **)&col->tipoId, nova, sizeof(*col->tipoId)) != 0
+        || realocarColuna((void **)&col->prioridade, nova, sizeof(*col->prioridade)) != 0
+        || realocarColuna((void **)&col->prefixoNome, nova, sizeof(*col->prefixoNome)) != 0
+        || realocarColuna((void **)&col->chaveNome, nova, sizeof(*col->chaveNome)) != 0)
+        return -1;
+    col->capacidade = nova;
+    return 0;
+}
+
+/* acrescenta uma linha com os campos (e chaves já calculadas) de c; 0 em sucesso */
+int colunasAcrescentar(ColunasComponentes *col, const Componente *c) {
+    if (colunasReservar(col, col->total + 1) != 0) return -1;
+    size_t i = col->total++;
+    memcpy(col->nome[i], c->nome, MAX_NOME);
+    col->tipoId[i] = c->tipoId;
+    col->prioridade[i] = (uint8_t)c->prioridade;
+    col->prefixoNome[i] = c->prefixoNome;
+    memcpy(col->chaveNome[i], c->chaveNome, TAM_CHAVE);
+    return 0;
+}
+
+/* (re)constrói as colunas a partir dos registros de v; 0 em sucesso */
+int colunasConstruir(ColunasComponentes *col, const VetorComponentes *v) {
+    col->total = 0;
+    if (colunasReservar(col, v->total) != 0) return -1;
+    for (size_t i = 0; i < v->total; ++i) colunasAcrescentar(col, &v->dados[i]);
+    return 0;
+}
+
+/* acesso aos campos independente do layout */
+static inline uint64_t fontePrefixoNome(const FonteComponentes *f, uint32_t id) {
+    return f->colunas ? f->colunas->prefixoNome[id] : f->registros[id].prefixoNome;
+}
+
+static inline const char *fonteChaveNome(const FonteComponentes *f, uint32_t id) {
+    return f->colunas ? f->colunas->chaveNome[id] : f->registros[id].chaveNome;
+}
+
+static inline uint32_t fonteTipoId(const FonteComponentes *f, uint32_t id) {
+    return f->colunas ? f->colunas->tipoId[id] : f->registros[id].tipoId;
+}
+
+static inline int fontePrioridade(const FonteComponentes *f, uint32_t id) {
+    return f->colunas ? f->colunas->prioridade[id] : f->registros[id].prioridade;
+}
+
 /* ---------------- utilitários ---------------- */
 
 /* remove newline no final da string (se presente) */
@@ -56,193 +471,3410 @@ int stricmp_local(const char *a, const char *b) {
     return (a[ia] == '\0') ? -1 : 1;
 }
 
-/* exibe vetor de componentes */
-void mostrarComponentes(const Componente arr[], int n) {
-    printf("\n--- Componentes (total: %d) ---\n", n);
+/*
+ * Relógio monotônico de alta resolução (nanossegundos), em segundos.
+ * Substitui clock(), que mede tempo de CPU com granularidade grossa.
+ */
+double relogioSeg(void) {
+    struct timespec ts;
+#ifdef CLOCK_MONOTONIC
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+#else
+    timespec_get(&ts, TIME_UTC);
+#endif
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/*
+ * Kernels de chave (comparação e conversão para minúsculas) sobre blocos de
+ * TAM_CHAVE bytes. Como as chaves têm tamanho fixo e são completadas com '\0',
+ * comparar dispensa strlen e desvios por caractere: o kernel vetorial compara o
+ * bloco inteiro, acha o primeiro byte distinto pela máscara e devolve a diferença
+ * como memcmp. A versão é escolhida uma vez em kernelChavesIniciar (AVX2 se a CPU
+ * suportar, senão SSE2, senão escalar); FREEFIRE_SIMD=escalar|sse2|avx2 força uma.
+ */
+typedef struct {
+    const char *nome;
+    int (*comparar)(const char *a, const char *b); /* blocos já em minúsculas */
+    void (*dobrar)(char *bloco);                   /* A-Z -> a-z no próprio bloco */
+} KernelChaves;
+
+static int compararChaveEscalar(const char *a, const char *b) {
+    return memcmp(a, b, TAM_CHAVE);
+}
+
+static void dobrarChaveEscalar(char *bloco) {
+    for (int i = 0; i < TAM_CHAVE; ++i) bloco[i] = (char)tolower((unsigned char)bloco[i]);
+}
+
+#ifdef USA_SIMD_X86
+static int compararChaveSse2(const char *a, const char *b) {
+    for (int off = 0; off < TAM_CHAVE; off += 16) {
+        __m128i va = _mm_loadu_si128((const __m128i *)(a + off));
+        __m128i vb = _mm_loadu_si128((const __m128i *)(b + off));
+        unsigned dif = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb)) ^ 0xFFFFu;
+        if (dif) {
+            int i = off + __builtin_ctz(dif);
+            return (unsigned char)a[i] - (unsigned char)b[i];
+        }
+    }
+    return 0;
+}
+
+/* bytes >= 0x80 são negativos na comparação com sinal e ficam fora de 'A'..'Z' */
+static void dobrarChaveSse2(char *bloco) {
+    const __m128i antesA = _mm_set1_epi8('A' - 1), depoisZ = _mm_set1_epi8('Z' + 1);
+    const __m128i dif = _mm_set1_epi8('a' - 'A');
+    for (int off = 0; off < TAM_CHAVE; off += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(bloco + off));
+        __m128i maiuscula = _mm_and_si128(_mm_cmpgt_epi8(v, antesA), _mm_cmpgt_epi8(depoisZ, v));
+        _mm_storeu_si128((__m128i *)(bloco + off), _mm_add_epi8(v, _mm_and_si128(maiuscula, dif)));
+    }
+}
+
+__attribute__((target("avx2")))
+static int compararChaveAvx2(const char *a, const char *b) {
+    __m256i va = _mm256_loadu_si256((const __m256i *)a);
+    __m256i vb = _mm256_loadu_si256((const __m256i *)b);
+    unsigned dif = ~(unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb));
+    if (!dif) return 0;
+    int i = __builtin_ctz(dif);
+    return (unsigned char)a[i] - (unsigned char)b[i];
+}
+
+__attribute__((target("avx2")))
+static void dobrarChaveAvx2(char *bloco) {
+    __m256i v = _mm256_loadu_si256((const __m256i *)bloco);
+    __m256i maiuscula = _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8('A' - 1)),
+                                         _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), v));
+    v = _mm256_add_epi8(v, _mm256_and_si256(maiuscula, _mm256_set1_epi8('a' - 'A')));
+    _mm256_storeu_si256((__m256i *)bloco, v);
+}
+#endif
+
+static const KernelChaves KERNEL_ESCALAR = { "escalar", compararChaveEscalar, dobrarChaveEscalar };
+#ifdef USA_SIMD_X86
+static const KernelChaves KERNEL_SSE2 = { "sse2", compararChaveSse2, dobrarChaveSse2 };
+static const KernelChaves KERNEL_AVX2 = { "avx2", compararChaveAvx2, dobrarChaveAvx2 };
+#endif
+
+static KernelChaves kernelChaves = { "escalar", compararChaveEscalar, dobrarChaveEscalar };
+
+/* escolhe o kernel de chaves para esta CPU; chamar uma vez no início de main */
+void kernelChavesIniciar(void) {
+    const char *forcado = getenv("FREEFIRE_SIMD");
+    kernelChaves = KERNEL_ESCALAR;
+#ifdef USA_SIMD_X86
+    __builtin_cpu_init();
+    if (forcado && strcmp(forcado, "escalar") == 0) return;
+    kernelChaves = KERNEL_SSE2;
+    if (forcado && strcmp(forcado, "sse2") == 0) return;
+    if (__builtin_cpu_supports("avx2")) kernelChaves = KERNEL_AVX2;
+#else
+    (void)forcado;
+#endif
+}
+
+/* mesma convenção de sinal que memcmp */
+static inline int compararChave(const char *a, const char *b) {
+    return kernelChaves.comparar(a, b);
+}
+
+/*
+ * Copia src para dst (TAM_CHAVE bytes) em minúsculas, preenchendo o restante com '\0',
+ * de modo que duas chaves se comparem com compararChave na mesma ordem que as
+ * strings originais sem distinção de caixa.
+ */
+void dobrarCaixa(char *dst, const char *src) {
+    size_t len = strnlen(src, TAM_CHAVE - 1);
+    memcpy(dst, src, len);
+    memset(dst + len, 0, TAM_CHAVE - len);
+    kernelChaves.dobrar(dst);
+}
+
+/* 8 primeiros bytes da chave em big-endian: comparar os inteiros equivale a memcmp desses bytes */
+uint64_t prefixoChave(const char *chave) {
+    uint64_t p = 0;
+    for (int i = 0; i < 8; ++i) p = (p << 8) | (unsigned char)chave[i];
+    return p;
+}
+
+/* recalcula a chave de comparação do nome; chamar sempre que o nome mudar */
+void componenteAtualizarChaves(Componente *c) {
+    dobrarCaixa(c->chaveNome, c->nome);
+    c->prefixoNome = prefixoChave(c->chaveNome);
+}
+
+/* compara pelo prefixo inteiro; só em empate de prefixo olha a chave completa */
+static inline int compararChavePrefixada(uint64_t prefixoA, const char *a, uint64_t prefixoB, const char *b) {
+    if (prefixoA != prefixoB) return prefixoA < prefixoB ? -1 : 1;
+    return compararChave(a, b);
+}
+
+/* ---------------- dicionário de tipos ---------------- */
+
+/* global como o kernel de chaves: os IDs valem para todo o processo e nunca mudam */
+static DicionarioTipos dicionarioTipos;
+
+/* FNV-1a sobre o texto exato do tipo */
+static uint32_t hashTipo(const char *texto) {
+    uint32_t h = 2166136261u;
+    for (const unsigned char *p = (const unsigned char *)texto; *p; ++p) {
+        h ^= *p;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static void tiposColocar(uint32_t id) {
+    DicionarioTipos *d = &dicionarioTipos;
+    size_t mascara = d->capacidadeSlots - 1;
+    size_t i = hashTipo(d->texto[id]) & mascara;
+    while (d->slots[i] != HASH_VAZIO) i = (i + 1) & mascara;
+    d->slots[i] = id;
+}
+
+/* garante espaço para mais um tipo (entradas e hash); retorna 0 em sucesso */
+static int tiposReservar(void) {
+    DicionarioTipos *d = &dicionarioTipos;
+    if (d->total == d->capacidade) {
+        size_t nova = d->capacidade ? d->capacidade * 2 : CAPACIDADE_INICIAL;
+        if (realocarColuna((void **)&d->texto, nova, sizeof(*d->texto)) != 0
+            || realocarColuna((void **)&d->chave, nova, sizeof(*d->chave)) != 0
+            || realocarColuna((void **)&d->rank, nova, sizeof(*d->rank)) != 0
+            || realocarColuna((void **)&d->ordem, nova, sizeof(*d->ordem)) != 0)
+            return -1;
+        d->capacidade = nova;
+    }
+    if ((d->total + 1) * 2 > d->capacidadeSlots) {
+        size_t nova = d->capacidadeSlots ? d->capacidadeSlots * 2 : HASH_CAPACIDADE_INICIAL;
+        uint32_t *slots = malloc(nova * sizeof(uint32_t));
+        if (!slots) return -1;
+        free(d->slots);
+        d->slots = slots;
+        d->capacidadeSlots = nova;
+        for (size_t i = 0; i < nova; ++i) slots[i] = HASH_VAZIO;
+        for (size_t id = 0; id < d->total; ++id) tiposColocar((uint32_t)id);
+    }
+    return 0;
+}
+
+/*
+ * Devolve o ID do tipo (texto truncado em MAX_TIPO-1 caracteres), criando-o
+ * se ainda não existir. Retorna TIPO_INVALIDO se faltar memória.
+ */
+uint32_t tipoInternar(const char *texto) {
+    DicionarioTipos *d = &dicionarioTipos;
+    char exato[MAX_TIPO];
+    size_t len = strnlen(texto, MAX_TIPO - 1);
+    memcpy(exato, texto, len);
+    memset(exato + len, 0, MAX_TIPO - len);
+
+    if (d->capacidadeSlots > 0) {
+        size_t mascara = d->capacidadeSlots - 1;
+        for (size_t i = hashTipo(exato) & mascara; d->slots[i] != HASH_VAZIO; i = (i + 1) & mascara) {
+            if (memcmp(d->texto[d->slots[i]], exato, MAX_TIPO) == 0) return d->slots[i];
+        }
+    }
+    if (d->total >= TIPO_INVALIDO || tiposReservar() != 0) return TIPO_INVALIDO;
+    uint32_t id = (uint32_t)d->total++;
+    memcpy(d->texto[id], exato, MAX_TIPO);
+    dobrarCaixa(d->chave[id], exato);
+    tiposColocar(id);
+    d->ranksValidos = 0;
+    return id;
+}
+
+/* cria o tipo padrão com ID TIPO_ID_PADRAO; chamar uma vez no início de main */
+int tiposIniciar(void) {
+    return tipoInternar(TIPO_PADRAO) == TIPO_ID_PADRAO ? 0 : -1;
+}
+
+/* texto do tipo para exibição */
+const char *tipoTexto(uint32_t id) {
+    return id < dicionarioTipos.total ? dicionarioTipos.texto[id] : "?";
+}
+
+static int compararOrdemTipos(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return compararChave(dicionarioTipos.chave[x], dicionarioTipos.chave[y]);
+}
+
+/*
+ * Recalcula rank[] se algum tipo foi criado desde o último cálculo: O(k log k)
+ * sobre os k tipos, não sobre os componentes. Chamar antes de ordenar por tipo.
+ */
+void tiposGarantirRanks(void) {
+    DicionarioTipos *d = &dicionarioTipos;
+    if (d->ranksValidos) return;
+    for (size_t i = 0; i < d->total; ++i) d->ordem[i] = (uint32_t)i;
+    qsort(d->ordem, d->total, sizeof(uint32_t), compararOrdemTipos);
+    uint32_t r = 0;
+    for (size_t i = 0; i < d->total; ++i) {
+        if (i > 0 && compararChave(d->chave[d->ordem[i-1]], d->chave[d->ordem[i]]) != 0) r++;
+        d->rank[d->ordem[i]] = r;
+    }
+    d->totalRanks = d->total ? (size_t)r + 1 : 0;
+    d->ranksValidos = 1;
+}
+
+/* associa o tipo (pelo texto; vazio = TIPO_PADRAO) ao componente; -1 se faltar memória */
+int componenteDefinirTipo(Componente *c, const char *texto) {
+    uint32_t id = tipoInternar(texto[0] ? texto : TIPO_PADRAO);
+    if (id == TIPO_INVALIDO) return -1;
+    c->tipoId = id;
+    return 0;
+}
+
+/* ---------------- comparação e exibição de componentes ---------------- */
+
+static int compararNome(const Componente *a, const Componente *b) {
+    return compararChavePrefixada(a->prefixoNome, a->chaveNome, b->prefixoNome, b->chaveNome);
+}
+
+/* pelo rank do tipo; requer tiposGarantirRanks() antes da ordenação */
+static int compararTipo(const Componente *a, const Componente *b) {
+    uint32_t ra = dicionarioTipos.rank[a->tipoId], rb = dicionarioTipos.rank[b->tipoId];
+    return (ra > rb) - (ra < rb);
+}
+
+/* cabeçalho da tabela de componentes; retorna 0 se houver linhas a exibir */
+static int mostrarCabecalho(size_t n) {
+    printf("\n--- Componentes (total: %zu) ---\n", n);
     if (n == 0) {
         printf("[vazio]\n");
-        return;
+        return -1;
     }
     printf("%-3s | %-28s | %-15s | %s\n", "ID", "NOME", "TIPO", "PRIORIDADE");
     printf("----+------------------------------+-----------------+----------\n");
-    for (int i = 0; i < n; ++i) {
-        printf("%-3d | %-28s | %-15s | %-8d\n", i+1, arr[i].nome, arr[i].tipo, arr[i].prioridade);
+    return 0;
+}
+
+/* linha da tabela a partir dos campos; formato único para registros e colunas */
+static void mostrarCampos(size_t id, const char *nome, uint32_t tipoId, int prioridade) {
+    printf("%-3zu | %-28s | %-15s | %-8d\n", id, nome, tipoTexto(tipoId), prioridade);
+}
+
+static void mostrarLinha(size_t id, const Componente *c) {
+    mostrarCampos(id, c->nome, c->tipoId, c->prioridade);
+}
+
+/* exibe o registro 'id' (posição no vetor) lendo da fonte; o ID mostrado é id + 1 */
+static void mostrarLinhaFonte(const FonteComponentes *f, uint32_t id) {
+    if (!f->colunas) {
+        mostrarLinha((size_t)id + 1, &f->registros[id]);
+        return;
     }
+    const ColunasComponentes *col = f->colunas;
+    mostrarCampos((size_t)id + 1, col->nome[id], col->tipoId[id], col->prioridade[id]);
+}
+
+/* exibe vetor de componentes */
+void mostrarComponentes(const VetorComponentes *v) {
+    if (mostrarCabecalho(v->total) != 0) return;
+    for (size_t i = 0; i < v->total; ++i) mostrarLinha(i+1, &v->dados[i]);
 }
 
-/* copia array (útil para testar/medir sem alterar original se necessário) */
-void copiarComponentes(const Componente src[], Componente dst[], int n) {
-    for (int i = 0; i < n; ++i) dst[i] = src[i];
+/* exibe os componentes na ordem de uma visão; o ID é a posição do registro no vetor */
+void mostrarComponentesVisao(const FonteComponentes *f, const VisaoIndices *visao) {
+    if (mostrarCabecalho(visao->total) != 0) return;
+    for (size_t i = 0; i < visao->total; ++i) mostrarLinhaFonte(f, visao->indices[i]);
+}
+
+/* copia vetor (útil para testar/medir sem alterar original se necessário); retorna 0 em sucesso */
+int copiarComponentes(const VetorComponentes *src, VetorComponentes *dst) {
+    if (vetorReservar(dst, src->total) != 0) return -1;
+    if (src->total > 0) memcpy(dst->dados, src->dados, src->total * sizeof(Componente));
+    dst->total = src->total;
+    return 0;
 }
 
 /* ---------------- algoritmos de ordenação com métricas ---------------- */
 
+/*
+ * Movimentos (atribuições de registros ou índices, incluindo temporários e buffers
+ * auxiliares) da última ordenação. Cada ordenação zera o contador ao começar;
+ * fica fora da assinatura para manter o contrato comparacoes/tempoSeg.
+ * Um contador por thread: as threads do merge sort paralelo contam sem disputa
+ * e a thread principal soma os totais no fim.
+ */
+static _Thread_local unsigned long long movimentosOrdenacao = 0;
+
+/* threads do merge sort paralelo; 0 = uma por processador online */
+static int threadsOrdenacao = 0;
+
 /*
  * Bubble Sort por nome (alfabético crescente)
  * Retorna o número de comparações em *comparacoes e tempo em segundos em *tempoSeg.
  */
-void bubbleSortNome(Componente arr[], int n, unsigned long long *comparacoes, double *tempoSeg) {
+void bubbleSortNome(VetorComponentes *v, unsigned long long *comparacoes, double *tempoSeg) {
+    Componente *arr = v->dados;
+    size_t n = v->total;
     *comparacoes = 0;
-    clock_t t0 = clock();
+    movimentosOrdenacao = 0;
+    double t0 = relogioSeg();
 
     int trocou;
-    for (int pass = 0; pass < n-1; ++pass) {
+    for (size_t pass = 0; pass + 1 < n; ++pass) {
         trocou = 0;
-        for (int i = 0; i < n-1-pass; ++i) {
+        for (size_t i = 0; i < n-1-pass; ++i) {
             (*comparacoes)++;
-            if (stricmp_local(arr[i].nome, arr[i+1].nome) > 0) {
+            if (compararNome(&arr[i], &arr[i+1]) > 0) {
                 /* troca */
                 Componente tmp = arr[i];
                 arr[i] = arr[i+1];
                 arr[i+1] = tmp;
+                movimentosOrdenacao += 3;
                 trocou = 1;
             }
         }
         if (!trocou) break; /* otimização: se já ordenado */
     }
 
-    clock_t t1 = clock();
-    *tempoSeg = (double)(t1 - t0) / CLOCKS_PER_SEC;
+    double t1 = relogioSeg();
+    *tempoSeg = t1 - t0;
 }
 
-/*
- * Insertion Sort por tipo (alfabético crescente)
- */
-void insertionSortTipo(Componente arr[], int n, unsigned long long *comparacoes, double *tempoSeg) {
-    *comparacoes = 0;
-    clock_t t0 = clock();
-
-    for (int i = 1; i < n; ++i) {
-        Componente key = arr[i];
-        int j = i - 1;
-        /* comparar tipos */
-        while (j >= 0) {
-            (*comparacoes)++;
-            if (stricmp_local(arr[j].tipo, key.tipo) > 0) {
-                arr[j+1] = arr[j];
-                j--;
-            } else {
-                break;
+/* ordena arr[lo, hi) recursivamente; aux precisa comportar metade do intervalo */
+static void mergeSortNomeRec(Componente arr[], Componente aux[], size_t lo, size_t hi, unsigned long long *comparacoes) {
+    if (hi - lo <= LIMIAR_INSERCAO) {
+        /* trechos pequenos: inserção (estável e sem recursão) */
+        for (size_t i = lo + 1; i < hi; ++i) {
+            Componente key = arr[i];
+            size_t j = i;
+            while (j > lo) {
+                (*comparacoes)++;
+                if (compararNome(&arr[j-1], &key) > 0) {
+                    arr[j] = arr[j-1];
+                    movimentosOrdenacao++;
+                    j--;
+                } else {
+                    break;
+                }
             }
+            arr[j] = key;
+            movimentosOrdenacao += 2;
         }
-        arr[j+1] = key;
+        return;
     }
 
-    clock_t t1 = clock();
-    *tempoSeg = (double)(t1 - t0) / CLOCKS_PER_SEC;
+    size_t mid = lo + (hi - lo) / 2;
+    mergeSortNomeRec(arr, aux, lo, mid, comparacoes);
+    mergeSortNomeRec(arr, aux, mid, hi, comparacoes);
+
+    /* metades já em ordem: nada a intercalar */
+    (*comparacoes)++;
+    if (compararNome(&arr[mid-1], &arr[mid]) <= 0) return;
+
+    /* copia só a metade esquerda; a direita é consumida no próprio vetor */
+    size_t nEsq = mid - lo;
+    memcpy(aux, &arr[lo], nEsq * sizeof(Componente));
+    size_t i = 0, j = mid, k = lo;
+    while (i < nEsq && j < hi) {
+        (*comparacoes)++;
+        if (compararNome(&aux[i], &arr[j]) <= 0) arr[k++] = aux[i++];
+        else arr[k++] = arr[j++];
+    }
+    while (i < nEsq) arr[k++] = aux[i++];
+    movimentosOrdenacao += nEsq + (k - lo); /* cópia para aux + escritas da intercalação */
 }
 
 /*
- * Selection Sort por prioridade (decrescente: maior prioridade primeiro)
+ * Merge Sort por nome (alfabético crescente, estável, O(n log n))
+ * Mesmo contrato de métricas do bubbleSortNome. Retorna 0 em sucesso, -1 se faltar memória.
  */
-void selectionSortPrioridade(Componente arr[], int n, unsigned long long *comparacoes, double *tempoSeg) {
+int mergeSortNome(VetorComponentes *v, unsigned long long *comparacoes, double *tempoSeg) {
     *comparacoes = 0;
-    clock_t t0 = clock();
+    movimentosOrdenacao = 0;
+    *tempoSeg = 0.0;
+    if (v->total < 2) return 0;
 
-    for (int i = 0; i < n-1; ++i) {
-        int idxMax = i;
-        for (int j = i+1; j < n; ++j) {
-            (*comparacoes)++;
-            if (arr[j].prioridade > arr[idxMax].prioridade) {
-                idxMax = j;
-            }
-        }
-        if (idxMax != i) {
-            Componente tmp = arr[i];
-            arr[i] = arr[idxMax];
-            arr[idxMax] = tmp;
-        }
-    }
+    Componente *aux = malloc((v->total / 2 + 1) * sizeof(Componente));
+    if (!aux) return -1;
+
+    double t0 = relogioSeg();
+    mergeSortNomeRec(v->dados, aux, 0, v->total, comparacoes);
+    double t1 = relogioSeg();
+    *tempoSeg = t1 - t0;
 
-    clock_t t1 = clock();
-    *tempoSeg = (double)(t1 - t0) / CLOCKS_PER_SEC;
+    free(aux);
+    return 0;
 }
 
-/* ---------------- busca binária por nome (após ordenação por nome) ---------------- */
-/*
- * Retorna índice do componente encontrado ou -1 se não achar.
- * Também preenche comparacoesBusca com o número de comparações feitas.
- * Utiliza comparação case-insensitive (stricmp_local).
- */
-int buscaBinariaPorNome(const Componente arr[], int n, const char chave[], unsigned long long *comparacoesBusca) {
-    int left = 0, right = n - 1;
-    *comparacoesBusca = 0;
-    while (left <= right) {
-        int mid = left + (right - left) / 2;
-        (*comparacoesBusca)++;
-        int cmp = stricmp_local(arr[mid].nome, chave);
-        if (cmp == 0) return mid;
-        if (cmp < 0) left = mid + 1;
-        else right = mid - 1;
-    }
-    return -1;
+/* ---------------- ordenações paralelas ---------------- */
+
+/* número de threads para ordenar n componentes: configurado (ou automático), limitado por LIMIAR_PARALELO */
+int threadsParaOrdenar(size_t n) {
+    long t = threadsOrdenacao;
+#ifdef USA_PTHREAD
+    if (t <= 0) t = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    if (t < 1) t = 1;
+    if (t > MAX_THREADS) t = MAX_THREADS;
+    size_t porTamanho = n / LIMIAR_PARALELO;
+    if (porTamanho < 1) porTamanho = 1;
+    if ((size_t)t > porTamanho) t = (long)porTamanho;
+    return (int)t;
 }
 
-/* ---------------- entrada de dados ---------------- */
+typedef enum { FASE_ORDENAR, FASE_INTERCALAR, FASE_COPIAR, FASE_CONTAR, FASE_DISTRIBUIR } FaseParalela;
 
-void cadastrarComponentes(Componente arr[], int *n) {
-    char buffer[128];
-    int quantidade;
-    *n = 0;
+/*
+ * Trabalho de uma thread. Na fase de ordenação [inicio, fim) é o bloco da thread;
+ * nas intercalações é a fatia da SAÍDA que ela escreve, de modo que todas as threads
+ * trabalham em todas as rodadas, inclusive na última (uma única intercalação de n).
+ * Na distribuição por baldes [inicio, fim) é o bloco de entrada e contagem guarda,
+ * por balde, primeiro o histograma do bloco e depois a próxima posição de escrita.
+ */
+typedef struct {
+    FaseParalela fase;
+    Componente *origem;
+    Componente *destino;
+    const size_t *limites;   /* sequências ordenadas da rodada: [limites[s], limites[s+1]) */
+    size_t totalSequencias;
+    size_t inicio, fim;
+    CriterioOrdenacao criterio;
+    size_t *contagem;
+    unsigned long long comparacoes;
+    unsigned long long movimentos;
+    double tempoSeg;         /* tempo de trabalho acumulado (sem espera pelas outras threads) */
+} TarefaOrdenacao;
 
-    printf("\nQuantos componentes deseja cadastrar? (1-%d): ", MAX_COMPONENTES);
-    if (fgets(buffer, sizeof(buffer), stdin) == NULL) return;
-    if (sscanf(buffer, "%d", &quantidade) != 1 || quantidade < 1) {
-        printf("Entrada inválida. Abortando cadastro.\n");
-        return;
+/*
+ * Quantos dos k primeiros elementos da intercalação estável de A (nA) e B (nB) vêm de A.
+ * Busca binária pela menor posição i com A[i] > B[k-i-1] (empates ficam com A).
+ */
+static size_t coRank(size_t k, const Componente A[], size_t nA, const Componente B[], size_t nB,
+                     unsigned long long *comparacoes) {
+    size_t lo = k > nB ? k - nB : 0, hi = k < nA ? k : nA;
+    while (lo < hi) {
+        size_t i = lo + (hi - lo) / 2, j = k - i;
+        (*comparacoes)++;
+        if (compararNome(&A[i], &B[j-1]) <= 0) lo = i + 1;
+        else hi = i;
     }
-    if (quantidade > MAX_COMPONENTES) quantidade = MAX_COMPONENTES;
+    return lo;
+}
 
-    for (int i = 0; i < quantidade; ++i) {
-        printf("\n--- Componente %d ---\n", i+1);
+/* intercala, para cada par de sequências (2p, 2p+1), só as posições de saída em [inicio, fim) */
+static void intercalarFatia(TarefaOrdenacao *t) {
+    const size_t *lim = t->limites;
+    size_t seq = t->totalSequencias;
+    for (size_t p = 0; 2 * p < seq; ++p) {
+        size_t a0 = lim[2*p];
+        size_t a1 = lim[2*p + 1];
+        size_t a2 = (2*p + 2 <= seq) ? lim[2*p + 2] : a1; /* sequência sem par: só copia */
+        size_t ini = t->inicio > a0 ? t->inicio : a0;
+        size_t fim = t->fim < a2 ? t->fim : a2;
+        if (ini >= fim) continue;
 
-        printf("Nome: ");
-        if (fgets(arr[i].nome, MAX_NOME, stdin) == NULL) arr[i].nome[0] = '\0';
-        trim_newline(arr[i].nome);
-        if (strlen(arr[i].nome) == 0) {
-            strncpy(arr[i].nome, "SEM_NOME", MAX_NOME-1);
-            arr[i].nome[MAX_NOME-1] = '\0';
+        const Componente *A = t->origem + a0, *B = t->origem + a1;
+        size_t nA = a1 - a0, nB = a2 - a1;
+        size_t i = coRank(ini - a0, A, nA, B, nB, &t->comparacoes);
+        size_t j = (ini - a0) - i;
+        for (size_t k = ini; k < fim; ++k) {
+            int usarA = (j >= nB);
+            if (!usarA && i < nA) {
+                t->comparacoes++;
+                usarA = compararNome(&A[i], &B[j]) <= 0;
+            }
+            t->destino[k] = usarA ? A[i++] : B[j++];
         }
+        t->movimentos += fim - ini;
+    }
+}
 
-        printf("Tipo (ex: controle, suporte, propulsao): ");
-        if (fgets(arr[i].tipo, MAX_TIPO, stdin) == NULL) arr[i].tipo[0] = '\0';
-        trim_newline(arr[i].tipo);
-        if (strlen(arr[i].tipo) == 0) {
-            strncpy(arr[i].tipo, "GENERIC", MAX_TIPO-1);
-            arr[i].tipo[MAX_TIPO-1] = '\0';
-        }
+/* balde do componente na distribuição paralela: rank do tipo ou prioridade invertida (maior primeiro) */
+static inline size_t baldeDoComponente(const Componente *c, CriterioOrdenacao criterio) {
+    return criterio == CRITERIO_TIPO ? dicionarioTipos.rank[c->tipoId] : (size_t)(PRIORIDADE_MAX - c->prioridade);
+}
 
-        int prio = -1;
-        do {
-            printf("Prioridade (1-10): ");
-            if (fgets(buffer, sizeof(buffer), stdin) == NULL) break;
-            if (sscanf(buffer, "%d", &prio) != 1 || prio < 1 || prio > 10) {
-                printf("Valor inválido. Tente novamente.\n");
-                prio = -1;
-            }
-        } while (prio == -1);
-        arr[i].prioridade = prio;
+static void *executarTarefaOrdenacao(void *arg) {
+    TarefaOrdenacao *t = arg;
+    double t0 = relogioSeg();
+    if (t->fase == FASE_ORDENAR) {
+        /*
+         * o buffer auxiliar da thread é o trecho correspondente de destino; a tarefa 0
+         * roda na thread chamadora, cujo contador é preservado: a tarefa conta só em
+         * t->movimentos, somado uma única vez ao final da ordenação
+         */
+        unsigned long long movimentosAntes = movimentosOrdenacao;
+        movimentosOrdenacao = 0;
+        if (t->fim - t->inicio > 1)
+            mergeSortNomeRec(t->origem, t->destino + t->inicio, t->inicio, t->fim, &t->comparacoes);
+        t->movimentos += movimentosOrdenacao;
+        movimentosOrdenacao = movimentosAntes;
+    } else if (t->fase == FASE_INTERCALAR) {
+        intercalarFatia(t);
+    } else if (t->fase == FASE_COPIAR) {
+        memcpy(t->destino + t->inicio, t->origem + t->inicio, (t->fim - t->inicio) * sizeof(Componente));
+        t->movimentos += t->fim - t->inicio;
+    } else if (t->fase == FASE_CONTAR) {
+        for (size_t i = t->inicio; i < t->fim; ++i) t->contagem[baldeDoComponente(&t->origem[i], t->criterio)]++;
+    } else {
+        /* a ordem do bloco é preservada dentro de cada balde: distribuição estável */
+        for (size_t i = t->inicio; i < t->fim; ++i)
+            t->destino[t->contagem[baldeDoComponente(&t->origem[i], t->criterio)]++] = t->origem[i];
+        t->movimentos += t->fim - t->inicio;
     }
-    *n = quantidade;
-    printf("\nCadastro concluído: %d componentes.\n", *n);
+    t->tempoSeg += relogioSeg() - t0;
+    return NULL;
 }
 
-/* ---------------- menu e fluxo ---------------- */
+/* roda a fase atual em todas as tarefas (a 0 na thread chamadora) e espera todas terminarem */
+static void executarFaseParalela(TarefaOrdenacao tarefas[], int threads) {
+#ifdef USA_PTHREAD
+    pthread_t ids[MAX_THREADS];
+    int criada[MAX_THREADS] = {0};
+    for (int t = 1; t < threads; ++t)
+        criada[t] = pthread_create(&ids[t], NULL, executarTarefaOrdenacao, &tarefas[t]) == 0;
+    executarTarefaOrdenacao(&tarefas[0]);
+    for (int t = 1; t < threads; ++t) {
+        if (criada[t]) pthread_join(ids[t], NULL);
+        else executarTarefaOrdenacao(&tarefas[t]); /* sem recursos para a thread: roda aqui mesmo */
+    }
+#else
+    for (int t = 0; t < threads; ++t) executarTarefaOrdenacao(&tarefas[t]);
+#endif
+}
+
+/*
+ * Merge Sort paralelo por nome (estável, mesmo resultado do mergeSortNome).
+ * Cada uma das 'threads' ordena um bloco contíguo; depois os blocos são intercalados
+ * aos pares em log2(threads) rodadas, cada thread escrevendo uma fatia igual da saída
+ * (posição de corte achada por coRank). threads <= 0 usa threadsOrdenacao.
+ * Métricas: comparações somadas de todas as threads, tempo total (parede) e, se
+ * temposThread não for NULL, o tempo de trabalho de cada thread (*threadsUsadas posições).
+ * Retorna 0 em sucesso, -1 se faltar memória.
+ */
+int mergeSortNomeParalelo(VetorComponentes *v, int threads, unsigned long long *comparacoes, double *tempoSeg,
+                          double temposThread[], int *threadsUsadas) {
+    size_t n = v->total;
+    *comparacoes = 0;
+    movimentosOrdenacao = 0;
+    *tempoSeg = 0.0;
+    int salvo = threadsOrdenacao;
+    if (threads > 0) threadsOrdenacao = threads;
+    threads = threadsParaOrdenar(n);
+    threadsOrdenacao = salvo;
+    *threadsUsadas = threads;
+    if (n < 2) {
+        if (temposThread) temposThread[0] = 0.0;
+        return 0;
+    }
+
+    Componente *tmp = malloc(n * sizeof(Componente));
+    TarefaOrdenacao *tarefas = calloc((size_t)threads, sizeof(TarefaOrdenacao));
+    size_t *limites = malloc(((size_t)threads + 1) * sizeof(size_t));
+    if (!tmp || !tarefas || !limites) {
+        free(tmp);
+        free(tarefas);
+        free(limites);
+        return -1;
+    }
+
+    double t0 = relogioSeg();
+    for (int t = 0; t <= threads; ++t) limites[t] = (size_t)t * n / (size_t)threads;
+    for (int t = 0; t < threads; ++t) {
+        tarefas[t].fase = FASE_ORDENAR;
+        tarefas[t].origem = v->dados;
+        tarefas[t].destino = tmp;
+        tarefas[t].inicio = limites[t];
+        tarefas[t].fim = limites[t+1];
+    }
+    executarFaseParalela(tarefas, threads);
+
+    /* rodadas de intercalação alternando entre v->dados e tmp */
+    Componente *origem = v->dados, *destino = tmp;
+    size_t sequencias = (size_t)threads;
+    while (sequencias > 1) {
+        for (int t = 0; t < threads; ++t) {
+            tarefas[t].fase = FASE_INTERCALAR;
+            tarefas[t].origem = origem;
+            tarefas[t].destino = destino;
+            tarefas[t].limites = limites;
+            tarefas[t].totalSequencias = sequencias;
+        }
+        executarFaseParalela(tarefas, threads);
+        /* as sequências 2p e 2p+1 viraram uma só */
+        size_t novas = (sequencias + 1) / 2;
+        for (size_t s = 1; s <= novas; ++s) limites[s] = limites[2*s < sequencias ? 2*s : sequencias];
+        sequencias = novas;
+        Componente *troca = origem;
+        origem = destino;
+        destino = troca;
+    }
+    if (origem != v->dados) {
+        for (int t = 0; t < threads; ++t) {
+            tarefas[t].fase = FASE_COPIAR;
+            tarefas[t].origem = origem;
+            tarefas[t].destino = v->dados;
+        }
+        executarFaseParalela(tarefas, threads);
+    }
+    double t1 = relogioSeg();
+    *tempoSeg = t1 - t0;
+
+    for (int t = 0; t < threads; ++t) {
+        *comparacoes += tarefas[t].comparacoes;
+        movimentosOrdenacao += tarefas[t].movimentos;
+        if (temposThread) temposThread[t] = tarefas[t].tempoSeg;
+    }
+    free(limites);
+    free(tarefas);
+    free(tmp);
+    return 0;
+}
+
+/*
+ * Bucket sort paralelo por tipo (rank no dicionário) ou por prioridade (decrescente).
+ * As chaves têm poucos valores, então cada valor é um balde e os baldes não precisam
+ * de ordenação interna: cada thread conta os baldes do seu bloco; a soma de prefixos
+ * por (balde, thread) dá a cada thread uma região exclusiva de cada balde na saída;
+ * então todas distribuem seus blocos ao mesmo tempo, sem travas. Estável, O(n + k·threads).
+ * Mesmo contrato de métricas do mergeSortNomeParalelo. Retorna 0 em sucesso, -1 se faltar memória.
+ */
+int bucketSortParalelo(VetorComponentes *v, CriterioOrdenacao criterio, unsigned long long *comparacoes,
+                       double *tempoSeg, double temposThread[], int *threadsUsadas) {
+    size_t n = v->total;
+    *comparacoes = 0;
+    movimentosOrdenacao = 0;
+    *tempoSeg = 0.0;
+    int threads = threadsParaOrdenar(n);
+    *threadsUsadas = threads;
+    if (n < 2) {
+        if (temposThread) temposThread[0] = 0.0;
+        return 0;
+    }
+
+    if (criterio == CRITERIO_TIPO) tiposGarantirRanks();
+    size_t baldes = (criterio == CRITERIO_TIPO) ? dicionarioTipos.totalRanks
+                                                : (size_t)(PRIORIDADE_MAX - PRIORIDADE_MIN + 1);
+    Componente *saida = malloc(n * sizeof(Componente));
+    TarefaOrdenacao *tarefas = calloc((size_t)threads, sizeof(TarefaOrdenacao));
+    size_t *contagens = calloc((size_t)threads * baldes, sizeof(size_t));
+    if (!saida || !tarefas || !contagens) {
+        free(saida);
+        free(tarefas);
+        free(contagens);
+        return -1;
+    }
+
+    double t0 = relogioSeg();
+    for (int t = 0; t < threads; ++t) {
+        tarefas[t].fase = FASE_CONTAR;
+        tarefas[t].origem = v->dados;
+        tarefas[t].destino = saida;
+        tarefas[t].inicio = (size_t)t * n / (size_t)threads;
+        tarefas[t].fim = (size_t)(t + 1) * n / (size_t)threads;
+        tarefas[t].criterio = criterio;
+        tarefas[t].contagem = contagens + (size_t)t * baldes;
+    }
+    executarFaseParalela(tarefas, threads);
+
+    /* balde b: thread 0 escreve primeiro, depois a 1, ... (preserva a ordem original) */
+    size_t acumulado = 0;
+    for (size_t b = 0; b < baldes; ++b) {
+        for (int t = 0; t < threads; ++t) {
+            size_t qtd = tarefas[t].contagem[b];
+            tarefas[t].contagem[b] = acumulado;
+            acumulado += qtd;
+        }
+    }
+    for (int t = 0; t < threads; ++t) tarefas[t].fase = FASE_DISTRIBUIR;
+    executarFaseParalela(tarefas, threads);
+    double t1 = relogioSeg();
+    *tempoSeg = t1 - t0;
+
+    for (int t = 0; t < threads; ++t) {
+        movimentosOrdenacao += tarefas[t].movimentos;
+        if (temposThread) temposThread[t] = tarefas[t].tempoSeg;
+    }
+    vetorTrocarDados(v, saida, n);
+    free(contagens);
+    free(tarefas);
+    return 0;
+}
+
+/*
+ * Insertion Sort por tipo (alfabético crescente)
+ */
+void insertionSortTipo(VetorComponentes *v, unsigned long long *comparacoes, double *tempoSeg) {
+    Componente *arr = v->dados;
+    size_t n = v->total;
+    *comparacoes = 0;
+    movimentosOrdenacao = 0;
+    double t0 = relogioSeg();
+    tiposGarantirRanks();
+
+    for (size_t i = 1; i < n; ++i) {
+        Componente key = arr[i];
+        size_t j = i;
+        /* comparar tipos (j aponta para a posição livre) */
+        while (j > 0) {
+            (*comparacoes)++;
+            if (compararTipo(&arr[j-1], &key) > 0) {
+                arr[j] = arr[j-1];
+                movimentosOrdenacao++;
+                j--;
+            } else {
+                break;
+            }
+        }
+        arr[j] = key;
+        movimentosOrdenacao += 2;
+    }
+
+    double t1 = relogioSeg();
+    *tempoSeg = t1 - t0;
+}
+
+/*
+ * Selection Sort por prioridade (decrescente: maior prioridade primeiro)
+ */
+void selectionSortPrioridade(VetorComponentes *v, unsigned long long *comparacoes, double *tempoSeg) {
+    Componente *arr = v->dados;
+    size_t n = v->total;
+    *comparacoes = 0;
+    movimentosOrdenacao = 0;
+    double t0 = relogioSeg();
+
+    for (size_t i = 0; i + 1 < n; ++i) {
+        size_t idxMax = i;
+        for (size_t j = i+1; j < n; ++j) {
+            (*comparacoes)++;
+            if (arr[j].prioridade > arr[idxMax].prioridade) {
+                idxMax = j;
+            }
+        }
+        if (idxMax != i) {
+            Componente tmp = arr[i];
+            arr[i] = arr[idxMax];
+            arr[idxMax] = tmp;
+            movimentosOrdenacao += 3;
+        }
+    }
+
+    double t1 = relogioSeg();
+    *tempoSeg = t1 - t0;
+}
+
+/*
+ * Counting Sort por prioridade (decrescente, estável, O(n + k) com k = PRIORIDADE_MAX)
+ * Não compara elementos entre si: *comparacoes fica em 0, o que permite
+ * contrastar diretamente com o Selection Sort no menu.
+ * Retorna 0 em sucesso, -1 se faltar memória.
+ */
+int countingSortPrioridade(VetorComponentes *v, unsigned long long *comparacoes, double *tempoSeg) {
+    size_t n = v->total;
+    *comparacoes = 0;
+    movimentosOrdenacao = 0;
+    *tempoSeg = 0.0;
+    if (n < 2) return 0;
+
+    Componente *saida = malloc(n * sizeof(Componente));
+    if (!saida) return -1;
+
+    double t0 = relogioSeg();
+
+    /* histograma por prioridade */
+    size_t contagem[PRIORIDADE_MAX + 1] = {0};
+    for (size_t i = 0; i < n; ++i) contagem[v->dados[i].prioridade]++;
+
+    /* posição inicial de cada prioridade, da maior para a menor */
+    size_t inicio[PRIORIDADE_MAX + 1];
+    size_t acumulado = 0;
+    for (int p = PRIORIDADE_MAX; p >= PRIORIDADE_MIN; --p) {
+        inicio[p] = acumulado;
+        acumulado += contagem[p];
+    }
+
+    /* distribuição na ordem original (estável) */
+    for (size_t i = 0; i < n; ++i) saida[inicio[v->dados[i].prioridade]++] = v->dados[i];
+    movimentosOrdenacao += n;
+
+    double t1 = relogioSeg();
+    *tempoSeg = t1 - t0;
+
+    vetorTrocarDados(v, saida, n);
+    return 0;
+}
+
+/* ---------------- ordenação por índices (registros ficam no lugar) ---------------- */
+
+static int compararNomeRegistros(const FonteComponentes *f, uint32_t a, uint32_t b) {
+    return compararNome(&f->registros[a], &f->registros[b]);
+}
+
+static int compararTipoRegistros(const FonteComponentes *f, uint32_t a, uint32_t b) {
+    return compararTipo(&f->registros[a], &f->registros[b]);
+}
+
+static int compararNomeColunas(const FonteComponentes *f, uint32_t a, uint32_t b) {
+    const ColunasComponentes *col = f->colunas;
+    return compararChavePrefixada(col->prefixoNome[a], col->chaveNome[a], col->prefixoNome[b], col->chaveNome[b]);
+}
+
+static int compararTipoColunas(const FonteComponentes *f, uint32_t a, uint32_t b) {
+    uint32_t ra = dicionarioTipos.rank[f->colunas->tipoId[a]], rb = dicionarioTipos.rank[f->colunas->tipoId[b]];
+    return (ra > rb) - (ra < rb);
+}
+
+/* decrescente: maior prioridade primeiro */
+static int compararPrioridadeDesc(const FonteComponentes *f, uint32_t a, uint32_t b) {
+    int pa = fontePrioridade(f, a), pb = fontePrioridade(f, b);
+    return (pa < pb) - (pa > pb);
+}
+
+/* o layout é fixo durante uma ordenação: escolhe o comparador uma vez, fora do laço */
+static ComparadorIndice comparadorDoCriterio(CriterioOrdenacao criterio, const FonteComponentes *f) {
+    switch (criterio) {
+        case CRITERIO_NOME: return f->colunas ? compararNomeColunas : compararNomeRegistros;
+        case CRITERIO_TIPO: return f->colunas ? compararTipoColunas : compararTipoRegistros;
+        default: return compararPrioridadeDesc;
+    }
+}
+
+void visaoIniciar(VisaoIndices *visao) {
+    visao->indices = NULL;
+    visao->total = 0;
+    visao->externo = 0;
+    visao->capacidade = 0;
+}
+
+void visaoLiberar(VisaoIndices *visao) {
+    if (!visao->externo) free(visao->indices);
+    visaoIniciar(visao);
+}
+
+/* substitui os índices por 'novo' (alocado no heap com visao->total posições) */
+static void visaoTrocarIndices(VisaoIndices *visao, uint32_t *novo) {
+    if (!visao->externo) free(visao->indices);
+    visao->indices = novo;
+    visao->externo = 0;
+    visao->capacidade = visao->total;
+}
+
+/* (re)cria a visão como permutação identidade 0..total-1; retorna 0 em sucesso */
+int visaoPreparar(VisaoIndices *visao, size_t total) {
+    if (total > UINT32_MAX) return -1; /* índices de 32 bits */
+    if (visao->externo || total > visao->capacidade || visao->indices == NULL) {
+        size_t n = total ? total : 1;
+        uint32_t *novo = visao->externo ? malloc(n * sizeof(uint32_t))
+                                        : realloc(visao->indices, n * sizeof(uint32_t));
+        if (!novo) return -1;
+        visao->indices = novo;
+        visao->externo = 0;
+        visao->capacidade = n;
+    }
+    visao->total = total;
+    for (size_t i = 0; i < total; ++i) visao->indices[i] = (uint32_t)i;
+    return 0;
+}
+
+/*
+ * Insere 'id' na visão já ordenada por cmp, depois dos iguais (como o merge sort
+ * estável faria, já que id é o registro mais novo): busca binária da posição e um
+ * memmove do restante, O(log n) comparações em vez de reordenar tudo.
+ * Retorna a posição em que id entrou, ou -1 sem memória.
+ */
+long visaoInserirOrdenado(VisaoIndices *visao, const FonteComponentes *f, uint32_t id, ComparadorIndice cmp,
+                          unsigned long long *comparacoes) {
+    if (visao->total >= UINT32_MAX) return -1;
+    if (visao->externo || visao->total == visao->capacidade) {
+        size_t nova = visao->capacidade ? visao->capacidade : CAPACIDADE_INICIAL;
+        while (nova <= visao->total) nova *= 2;
+        uint32_t *novo = visao->externo ? malloc(nova * sizeof(uint32_t))
+                                        : realloc(visao->indices, nova * sizeof(uint32_t));
+        if (!novo) return -1;
+        if (visao->externo) memcpy(novo, visao->indices, visao->total * sizeof(uint32_t));
+        visao->indices = novo;
+        visao->externo = 0;
+        visao->capacidade = nova;
+    }
+
+    size_t lo = 0, hi = visao->total;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        (*comparacoes)++;
+        if (cmp(f, visao->indices[mid], id) <= 0) lo = mid + 1;
+        else hi = mid;
+    }
+    memmove(&visao->indices[lo + 1], &visao->indices[lo], (visao->total - lo) * sizeof(uint32_t));
+    visao->indices[lo] = id;
+    visao->total++;
+    return (long)lo;
+}
+
+/* merge sort estável de idx[lo, hi); mesma estrutura do mergeSortNomeRec, movendo só índices */
+static void mergeSortIndicesRec(const FonteComponentes *f, uint32_t idx[], uint32_t aux[], size_t lo, size_t hi,
+                                ComparadorIndice cmp, unsigned long long *comparacoes) {
+    if (hi - lo <= LIMIAR_INSERCAO) {
+        for (size_t i = lo + 1; i < hi; ++i) {
+            uint32_t key = idx[i];
+            size_t j = i;
+            while (j > lo) {
+                (*comparacoes)++;
+                if (cmp(f, idx[j-1], key) > 0) {
+                    idx[j] = idx[j-1];
+                    movimentosOrdenacao++;
+                    j--;
+                } else {
+                    break;
+                }
+            }
+            idx[j] = key;
+            movimentosOrdenacao += 2;
+        }
+        return;
+    }
+
+    size_t mid = lo + (hi - lo) / 2;
+    mergeSortIndicesRec(f, idx, aux, lo, mid, cmp, comparacoes);
+    mergeSortIndicesRec(f, idx, aux, mid, hi, cmp, comparacoes);
+
+    (*comparacoes)++;
+    if (cmp(f, idx[mid-1], idx[mid]) <= 0) return;
+
+    size_t nEsq = mid - lo;
+    memcpy(aux, &idx[lo], nEsq * sizeof(uint32_t));
+    size_t i = 0, j = mid, k = lo;
+    while (i < nEsq && j < hi) {
+        (*comparacoes)++;
+        if (cmp(f, aux[i], idx[j]) <= 0) idx[k++] = aux[i++];
+        else idx[k++] = idx[j++];
+    }
+    while (i < nEsq) idx[k++] = aux[i++];
+    movimentosOrdenacao += nEsq + (k - lo);
+}
+
+/* counting sort estável da visão por tipo: a chave é o rank do tipo (0 .. totalRanks-1) */
+static int countingSortIndicesTipo(const FonteComponentes *f, VisaoIndices *visao) {
+    tiposGarantirRanks();
+    const uint32_t *rank = dicionarioTipos.rank;
+    size_t n = visao->total, k = dicionarioTipos.totalRanks;
+    uint32_t *saida = malloc(n * sizeof(uint32_t));
+    size_t *inicio = calloc(k + 1, sizeof(size_t));
+    if (!saida || !inicio) {
+        free(saida);
+        free(inicio);
+        return -1;
+    }
+
+    /* inicio[r + 1] conta o rank r; a soma de prefixos dá a primeira posição de cada rank */
+    for (size_t i = 0; i < n; ++i) inicio[rank[fonteTipoId(f, visao->indices[i])] + 1]++;
+    for (size_t r = 1; r <= k; ++r) inicio[r] += inicio[r - 1];
+
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t id = visao->indices[i];
+        saida[inicio[rank[fonteTipoId(f, id)]]++] = id;
+    }
+    movimentosOrdenacao += n;
+
+    free(inicio);
+    visaoTrocarIndices(visao, saida);
+    return 0;
+}
+
+/* counting sort estável da visão por prioridade (decrescente) */
+static int countingSortIndicesPrioridade(const FonteComponentes *f, VisaoIndices *visao) {
+    size_t n = visao->total;
+    uint32_t *saida = malloc(n * sizeof(uint32_t));
+    if (!saida) return -1;
+
+    size_t contagem[PRIORIDADE_MAX + 1] = {0};
+    for (size_t i = 0; i < n; ++i) contagem[fontePrioridade(f, visao->indices[i])]++;
+
+    size_t inicio[PRIORIDADE_MAX + 1];
+    size_t acumulado = 0;
+    for (int p = PRIORIDADE_MAX; p >= PRIORIDADE_MIN; --p) {
+        inicio[p] = acumulado;
+        acumulado += contagem[p];
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t id = visao->indices[i];
+        saida[inicio[fontePrioridade(f, id)]++] = id;
+    }
+    movimentosOrdenacao += n;
+
+    visaoTrocarIndices(visao, saida);
+    return 0;
+}
+
+/* ordena a visão de 'total' registros lidos de f; núcleo comum de ordenarVisao e ordenarVisaoColunas */
+static int ordenarVisaoFonte(const FonteComponentes *f, size_t total, VisaoIndices *visao, CriterioOrdenacao criterio,
+                             unsigned long long *comparacoes, double *tempoSeg) {
+    *comparacoes = 0;
+    movimentosOrdenacao = 0;
+    *tempoSeg = 0.0;
+    if (visaoPreparar(visao, total) != 0) return -1;
+    if (visao->total < 2) return 0;
+
+    double t0 = relogioSeg();
+    if (criterio == CRITERIO_PRIORIDADE) {
+        if (countingSortIndicesPrioridade(f, visao) != 0) return -1;
+    } else if (criterio == CRITERIO_TIPO) {
+        if (countingSortIndicesTipo(f, visao) != 0) return -1;
+    } else {
+        uint32_t *aux = malloc((visao->total / 2 + 1) * sizeof(uint32_t));
+        if (!aux) return -1;
+        mergeSortIndicesRec(f, visao->indices, aux, 0, visao->total, comparadorDoCriterio(criterio, f), comparacoes);
+        free(aux);
+    }
+    double t1 = relogioSeg();
+    *tempoSeg = t1 - t0;
+    return 0;
+}
+
+/*
+ * Ordena a visão pelo critério, sem mover os registros de v: nome usa merge sort
+ * estável sobre índices; tipo (pelo rank no dicionário) e prioridade, counting sort.
+ * Mesmo contrato de métricas das ordenações por registro. Retorna 0 em sucesso, -1 em erro.
+ */
+int ordenarVisao(const VetorComponentes *v, VisaoIndices *visao, CriterioOrdenacao criterio,
+                 unsigned long long *comparacoes, double *tempoSeg) {
+    FonteComponentes f = { v->dados, NULL };
+    return ordenarVisaoFonte(&f, v->total, visao, criterio, comparacoes, tempoSeg);
+}
+
+/* como ordenarVisao, lendo só as colunas do critério (a permutação resultante é a mesma) */
+int ordenarVisaoColunas(const ColunasComponentes *col, VisaoIndices *visao, CriterioOrdenacao criterio,
+                        unsigned long long *comparacoes, double *tempoSeg) {
+    FonteComponentes f = { NULL, col };
+    return ordenarVisaoFonte(&f, col->total, visao, criterio, comparacoes, tempoSeg);
+}
+
+/* ---------------- índice hash por nome ---------------- */
+
+/* FNV-1a sobre o nome convertido para minúsculas (mesmo valor para o nome e sua chaveNome);
+ * lê no máximo TAM_CHAVE bytes, o tamanho das chaves recebidas */
+static uint32_t hashNomeCaseFold(const char *nome) {
+    uint32_t h = 2166136261u;
+    const unsigned char *p = (const unsigned char *)nome;
+    for (size_t i = 0; i < TAM_CHAVE && p[i]; ++i) {
+        h ^= (uint32_t)tolower(p[i]);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+void hashIniciar(IndiceHash *h) {
+    h->slots = NULL;
+    h->capacidade = 0;
+    h->ocupados = 0;
+}
+
+void hashLiberar(IndiceHash *h) {
+    free(h->slots);
+    hashIniciar(h);
+}
+
+/* esvazia o índice mantendo a tabela alocada */
+void hashLimpar(IndiceHash *h) {
+    for (size_t i = 0; i < h->capacidade; ++i) h->slots[i] = HASH_VAZIO;
+    h->ocupados = 0;
+}
+
+static void hashColocar(IndiceHash *h, const Componente base[], uint32_t id) {
+    size_t mascara = h->capacidade - 1;
+    size_t i = hashNomeCaseFold(base[id].chaveNome) & mascara;
+    while (h->slots[i] != HASH_VAZIO) i = (i + 1) & mascara;
+    h->slots[i] = id;
+    h->ocupados++;
+}
+
+/* realoca a tabela com a nova capacidade e reinsere os ocupados; retorna 0 em sucesso */
+static int hashRedimensionar(IndiceHash *h, const Componente base[], size_t capacidade) {
+    uint32_t *antigos = h->slots;
+    size_t capAntiga = h->capacidade;
+    uint32_t *novos = malloc(capacidade * sizeof(uint32_t));
+    if (!novos) return -1;
+    h->slots = novos;
+    h->capacidade = capacidade;
+    hashLimpar(h);
+    for (size_t i = 0; i < capAntiga; ++i) {
+        if (antigos[i] != HASH_VAZIO) hashColocar(h, base, antigos[i]);
+    }
+    free(antigos);
+    return 0;
+}
+
+/* indexa o registro base[id]; retorna 0 em sucesso, -1 sem memória */
+int hashInserir(IndiceHash *h, const Componente base[], uint32_t id) {
+    if ((h->ocupados + 1) * 2 > h->capacidade) {
+        size_t nova = h->capacidade ? h->capacidade * 2 : HASH_CAPACIDADE_INICIAL;
+        if (hashRedimensionar(h, base, nova) != 0) return -1;
+    }
+    hashColocar(h, base, id);
+    return 0;
+}
+
+/* reconstrói o índice para todos os registros do vetor; retorna 0 em sucesso */
+int hashReconstruir(IndiceHash *h, const VetorComponentes *v) {
+    if (v->total > UINT32_MAX) return -1;
+    size_t capacidade = HASH_CAPACIDADE_INICIAL;
+    while (capacidade < v->total * 2) capacidade *= 2;
+    if (capacidade > h->capacidade) {
+        uint32_t *novos = realloc(h->slots, capacidade * sizeof(uint32_t));
+        if (!novos) return -1;
+        h->slots = novos;
+        h->capacidade = capacidade;
+    }
+    hashLimpar(h);
+    for (size_t i = 0; i < v->total; ++i) hashColocar(h, v->dados, (uint32_t)i);
+    return 0;
+}
+
+/*
+ * Busca exata (case-insensitive) pelo nome.
+ * Retorna o índice do registro (o primeiro inserido, se houver nomes repetidos) ou -1.
+ * *sondagens recebe o número de slots examinados, no mesmo espírito do contador de comparações.
+ */
+long hashBuscarPorNome(const IndiceHash *h, const FonteComponentes *f, const char chave[], unsigned long long *sondagens) {
+    *sondagens = 0;
+    if (h->capacidade == 0 || strlen(chave) >= MAX_NOME) return -1;
+    char chaveDobrada[TAM_CHAVE];
+    dobrarCaixa(chaveDobrada, chave);
+    uint64_t prefixo = prefixoChave(chaveDobrada);
+    size_t mascara = h->capacidade - 1;
+    size_t i = hashNomeCaseFold(chaveDobrada) & mascara;
+    while (1) {
+        (*sondagens)++;
+        uint32_t id = h->slots[i];
+        if (id == HASH_VAZIO) return -1;
+        if (fontePrefixoNome(f, id) == prefixo && compararChave(fonteChaveNome(f, id), chaveDobrada) == 0) return (long)id;
+        i = (i + 1) & mascara;
+    }
+}
+
+/* ---------------- ordenação composta (várias chaves em uma passada) ---------------- */
+
+/*
+ * Cada registro recebe uma chave empacotada de 64 bits: as chaves da especificação
+ * ocupam, em ordem de precedência, os bits mais significativos ainda livres (tipo:
+ * rank no dicionário; prioridade: valor - PRIORIDADE_MIN; nome: os bits iniciais
+ * do prefixo), já invertidas quando decrescentes. Assim a maioria dos pares se
+ * resolve com uma comparação de inteiros; o comparador fundido só desempata
+ * quando a chave empacotada não cobre todas as chaves (nome nunca cabe inteiro).
+ */
+typedef struct {
+    uint64_t chave;
+    uint32_t id;
+} ItemComposto;
+
+typedef struct {
+    const FonteComponentes *f;
+    int total;                        /* chaves da especificação */
+    CriterioOrdenacao criterio[TOTAL_CRITERIOS];
+    int decrescente[TOTAL_CRITERIOS];
+    ComparadorIndice cmp[TOTAL_CRITERIOS];
+    int sinal[TOTAL_CRITERIOS];       /* -1 inverte o comparador do critério */
+    int bits[TOTAL_CRITERIOS];        /* bits de cada chave empacotada */
+    int empacotadas;                  /* chaves (prefixo da especificação) na chave de 64 bits */
+    int inicioDesempate;              /* primeira chave não resolvida pela chave empacotada */
+} PlanoComposto;
+
+/* menor número de bits que representa 'valores' valores distintos */
+static int bitsParaValores(size_t valores) {
+    int bits = 0;
+    while (bits < 64 && ((uint64_t)1 << bits) < valores) bits++;
+    return bits;
+}
+
+static void planoCompostoPreparar(PlanoComposto *p, const FonteComponentes *f, const EspecificacaoOrdenacao *esp) {
+    int livres = 64;
+    p->f = f;
+    p->total = esp->total;
+    p->empacotadas = 0;
+    p->inicioDesempate = esp->total;
+    for (int k = 0; k < esp->total; ++k) {
+        CriterioOrdenacao c = esp->criterio[k];
+        p->criterio[k] = c;
+        p->decrescente[k] = esp->decrescente[k];
+        p->cmp[k] = comparadorDoCriterio(c, f);
+        /* o comparador de prioridade já é decrescente */
+        p->sinal[k] = (esp->decrescente[k] == (c == CRITERIO_PRIORIDADE)) ? 1 : -1;
+        p->bits[k] = 0;
+        if (p->inicioDesempate < esp->total) continue;
+
+        int bits = (c == CRITERIO_NOME) ? livres
+                 : (c == CRITERIO_TIPO) ? bitsParaValores(dicionarioTipos.totalRanks)
+                                        : bitsParaValores(PRIORIDADE_MAX - PRIORIDADE_MIN + 1);
+        if (bits > livres || (c == CRITERIO_NOME && bits == 0)) {
+            p->inicioDesempate = k;
+            continue;
+        }
+        p->bits[k] = bits;
+        p->empacotadas = k + 1;
+        livres -= bits;
+        if (c == CRITERIO_NOME) p->inicioDesempate = k; /* o prefixo pode empatar */
+    }
+}
+
+static uint64_t chaveComposta(const PlanoComposto *p, uint32_t id) {
+    uint64_t chave = 0;
+    int livres = 64;
+    for (int k = 0; k < p->empacotadas; ++k) {
+        int bits = p->bits[k];
+        if (bits == 0) continue;
+        uint64_t maximo = (bits == 64) ? UINT64_MAX : ((uint64_t)1 << bits) - 1;
+        uint64_t valor;
+        if (p->criterio[k] == CRITERIO_NOME) {
+            uint64_t prefixo = fontePrefixoNome(p->f, id);
+            valor = (bits == 64) ? prefixo : prefixo >> (64 - bits);
+        } else if (p->criterio[k] == CRITERIO_TIPO) {
+            valor = dicionarioTipos.rank[fonteTipoId(p->f, id)];
+        } else {
+            valor = (uint64_t)(fontePrioridade(p->f, id) - PRIORIDADE_MIN);
+        }
+        if (p->decrescente[k]) valor = maximo - valor;
+        livres -= bits;
+        chave |= valor << livres;
+    }
+    return chave;
+}
+
+/* comparador fundido: chave empacotada e, se preciso, as chaves restantes uma a uma */
+static inline int compararItensCompostos(const PlanoComposto *p, const ItemComposto *a, const ItemComposto *b) {
+    if (a->chave != b->chave) return (a->chave < b->chave) ? -1 : 1;
+    for (int k = p->inicioDesempate; k < p->total; ++k) {
+        int c = p->cmp[k](p->f, a->id, b->id);
+        if (c != 0) return c * p->sinal[k];
+    }
+    return 0;
+}
+
+/* merge sort estável de itens[lo, hi); mesma estrutura do mergeSortIndicesRec */
+static void mergeSortCompostoRec(const PlanoComposto *p, ItemComposto itens[], ItemComposto aux[], size_t lo, size_t hi,
+                                 unsigned long long *comparacoes) {
+    if (hi - lo <= LIMIAR_INSERCAO) {
+        for (size_t i = lo + 1; i < hi; ++i) {
+            ItemComposto key = itens[i];
+            size_t j = i;
+            while (j > lo) {
+                (*comparacoes)++;
+                if (compararItensCompostos(p, &itens[j-1], &key) > 0) {
+                    itens[j] = itens[j-1];
+                    movimentosOrdenacao++;
+                    j--;
+                } else {
+                    break;
+                }
+            }
+            itens[j] = key;
+            movimentosOrdenacao += 2;
+        }
+        return;
+    }
+
+    size_t mid = lo + (hi - lo) / 2;
+    mergeSortCompostoRec(p, itens, aux, lo, mid, comparacoes);
+    mergeSortCompostoRec(p, itens, aux, mid, hi, comparacoes);
+
+    (*comparacoes)++;
+    if (compararItensCompostos(p, &itens[mid-1], &itens[mid]) <= 0) return;
+
+    size_t nEsq = mid - lo;
+    memcpy(aux, &itens[lo], nEsq * sizeof(ItemComposto));
+    size_t i = 0, j = mid, k = lo;
+    while (i < nEsq && j < hi) {
+        (*comparacoes)++;
+        if (compararItensCompostos(p, &aux[i], &itens[j]) <= 0) itens[k++] = aux[i++];
+        else itens[k++] = itens[j++];
+    }
+    while (i < nEsq) itens[k++] = aux[i++];
+    movimentosOrdenacao += nEsq + (k - lo);
+}
+
+/*
+ * Ordena a visão de 'total' registros lidos de f por todas as chaves de esp em uma
+ * única ordenação estável (empates completos mantêm a ordem de inserção).
+ * Mesmo contrato de métricas de ordenarVisao. Retorna 0 em sucesso, -1 em erro.
+ */
+int ordenarVisaoComposta(const FonteComponentes *f, size_t total, VisaoIndices *visao,
+                         const EspecificacaoOrdenacao *esp, unsigned long long *comparacoes, double *tempoSeg) {
+    *comparacoes = 0;
+    movimentosOrdenacao = 0;
+    *tempoSeg = 0.0;
+    if (esp->total < 1 || esp->total > TOTAL_CRITERIOS) return -1;
+    if (visaoPreparar(visao, total) != 0) return -1;
+    if (visao->total < 2) return 0;
+
+    size_t n = visao->total;
+    ItemComposto *itens = malloc(n * sizeof(ItemComposto));
+    ItemComposto *aux = malloc((n / 2 + 1) * sizeof(ItemComposto));
+    if (!itens || !aux) {
+        free(itens);
+        free(aux);
+        return -1;
+    }
+
+    double t0 = relogioSeg();
+    tiposGarantirRanks();
+    PlanoComposto plano;
+    planoCompostoPreparar(&plano, f, esp);
+    for (size_t i = 0; i < n; ++i) {
+        itens[i].id = (uint32_t)i;
+        itens[i].chave = chaveComposta(&plano, (uint32_t)i);
+    }
+    mergeSortCompostoRec(&plano, itens, aux, 0, n, comparacoes);
+    for (size_t i = 0; i < n; ++i) visao->indices[i] = itens[i].id;
+    double t1 = relogioSeg();
+    *tempoSeg = t1 - t0;
+
+    free(itens);
+    free(aux);
+    return 0;
+}
+
+/* ---------------- seleção dos K mais prioritários (heap) ---------------- */
+
+/*
+ * a vem antes de b na ordem por prioridade decrescente; empates ficam com o
+ * registro inserido antes, como na visão por prioridade (counting sort estável)
+ */
+static inline int topKAntes(const FonteComponentes *f, uint32_t a, uint32_t b, unsigned long long *comparacoes) {
+    (*comparacoes)++;
+    int pa = fontePrioridade(f, a), pb = fontePrioridade(f, b);
+    return pa > pb || (pa == pb && a < b);
+}
+
+/* heap de mínimo (a raiz é o pior dos K selecionados): desce heap[i] até o lugar */
+static void topKDescer(const FonteComponentes *f, uint32_t heap[], size_t n, size_t i, unsigned long long *comparacoes) {
+    uint32_t item = heap[i];
+    while (2 * i + 1 < n) {
+        size_t filho = 2 * i + 1;
+        if (filho + 1 < n && topKAntes(f, heap[filho], heap[filho + 1], comparacoes)) filho++;
+        if (!topKAntes(f, item, heap[filho], comparacoes)) break;
+        heap[i] = heap[filho];
+        movimentosOrdenacao++;
+        i = filho;
+    }
+    heap[i] = item;
+}
+
+/*
+ * Seleciona os k registros de maior prioridade entre os 'total' de f sem ordenar o
+ * resto: um heap de mínimo com os k melhores vistos até agora, O(n log k). saida
+ * (capacidade k) recebe os IDs em ordem decrescente de prioridade, na mesma ordem
+ * da visão por prioridade. Retorna quantos IDs foram escritos (min(k, total)).
+ */
+size_t selecionarTopK(const FonteComponentes *f, size_t total, size_t k, uint32_t saida[],
+                      unsigned long long *comparacoes, double *tempoSeg) {
+    *comparacoes = 0;
+    movimentosOrdenacao = 0;
+    *tempoSeg = 0.0;
+    if (k > total) k = total;
+    if (k == 0) return 0;
+
+    double t0 = relogioSeg();
+    size_t n = 0;
+    for (size_t i = 0; i < total; ++i) {
+        uint32_t id = (uint32_t)i;
+        if (n < k) {
+            /* sobe o novo item até o lugar */
+            size_t j = n++;
+            while (j > 0 && topKAntes(f, saida[(j - 1) / 2], id, comparacoes)) {
+                saida[j] = saida[(j - 1) / 2];
+                movimentosOrdenacao++;
+                j = (j - 1) / 2;
+            }
+            saida[j] = id;
+            continue;
+        }
+        /* o pior selecionado já tem a prioridade máxima: ninguém depois dele o supera */
+        if (fontePrioridade(f, saida[0]) == PRIORIDADE_MAX) break;
+        if (!topKAntes(f, id, saida[0], comparacoes)) continue;
+        saida[0] = id;
+        movimentosOrdenacao++;
+        topKDescer(f, saida, n, 0, comparacoes);
+    }
+
+    /* extrai o pior para o fim repetidamente: o heap vira a lista em ordem decrescente */
+    for (size_t fim = n - 1; fim > 0; --fim) {
+        uint32_t pior = saida[0];
+        saida[0] = saida[fim];
+        saida[fim] = pior;
+        movimentosOrdenacao += 2;
+        topKDescer(f, saida, fim, 0, comparacoes);
+    }
+    double t1 = relogioSeg();
+    *tempoSeg = t1 - t0;
+    return n;
+}
+
+/* ---------------- fila de prioridade por baldes (montagem da torre) ---------------- */
+
+void filaIniciar(FilaPrioridade *fila) {
+    for (int p = 0; p <= PRIORIDADE_MAX; ++p) fila->cabeca[p] = fila->cauda[p] = FILA_SEM_ID;
+    fila->proximo = fila->anterior = NULL;
+    fila->balde = NULL;
+    fila->capacidade = 0;
+    fila->total = 0;
+    fila->maior = 0;
+}
+
+void filaLiberar(FilaPrioridade *fila) {
+    free(fila->proximo);
+    free(fila->anterior);
+    free(fila->balde);
+    filaIniciar(fila);
+}
+
+/* esvazia a fila (mantém a memória alocada) */
+void filaLimpar(FilaPrioridade *fila) {
+    for (int p = 0; p <= PRIORIDADE_MAX; ++p) fila->cabeca[p] = fila->cauda[p] = FILA_SEM_ID;
+    if (fila->balde) memset(fila->balde, 0, fila->capacidade);
+    fila->total = 0;
+    fila->maior = 0;
+}
+
+/* garante IDs endereçáveis até minimo - 1 (crescimento x2, como o vetor); 0 em sucesso */
+int filaReservar(FilaPrioridade *fila, size_t minimo) {
+    if (minimo <= fila->capacidade) return 0;
+    if (minimo > (size_t)FILA_SEM_ID) return -1; /* IDs de 32 bits */
+    size_t nova = fila->capacidade ? fila->capacidade : CAPACIDADE_INICIAL;
+    while (nova < minimo) nova *= 2;
+    if (realocarColuna((void **)&fila->proximo, nova, sizeof(uint32_t)) != 0
+        || realocarColuna((void **)&fila->anterior, nova, sizeof(uint32_t)) != 0
+        || realocarColuna((void **)&fila->balde, nova, sizeof(uint8_t)) != 0)
+        return -1;
+    memset(fila->balde + fila->capacidade, 0, nova - fila->capacidade);
+    fila->capacidade = nova;
+    return 0;
+}
+
+static int filaContem(const FilaPrioridade *fila, uint32_t id) {
+    return id < fila->capacidade && fila->balde[id] != 0;
+}
+
+/* O(1): acrescenta id ao fim do balde da prioridade; -1 se já estiver na fila ou sem memória */
+int filaInserir(FilaPrioridade *fila, uint32_t id, int prioridade) {
+    if (prioridade < PRIORIDADE_MIN || prioridade > PRIORIDADE_MAX) return -1;
+    if (filaReservar(fila, (size_t)id + 1) != 0 || fila->balde[id] != 0) return -1;
+    fila->balde[id] = (uint8_t)prioridade;
+    fila->proximo[id] = FILA_SEM_ID;
+    fila->anterior[id] = fila->cauda[prioridade];
+    if (fila->cauda[prioridade] == FILA_SEM_ID) fila->cabeca[prioridade] = id;
+    else fila->proximo[fila->cauda[prioridade]] = id;
+    fila->cauda[prioridade] = id;
+    if (prioridade > fila->maior) fila->maior = prioridade;
+    fila->total++;
+    return 0;
+}
+
+/* O(1): tira id da fila; -1 se ele não estiver nela */
+int filaRemover(FilaPrioridade *fila, uint32_t id) {
+    if (!filaContem(fila, id)) return -1;
+    int p = fila->balde[id];
+    uint32_t ant = fila->anterior[id], prox = fila->proximo[id];
+    if (ant == FILA_SEM_ID) fila->cabeca[p] = prox;
+    else fila->proximo[ant] = prox;
+    if (prox == FILA_SEM_ID) fila->cauda[p] = ant;
+    else fila->anterior[prox] = ant;
+    fila->balde[id] = 0;
+    fila->total--;
+    return 0;
+}
+
+/* O(1): move id para o balde da nova prioridade (fim da ordem de chegada); -1 se fora da fila */
+int filaAlterarPrioridade(FilaPrioridade *fila, uint32_t id, int prioridade) {
+    if (prioridade < PRIORIDADE_MIN || prioridade > PRIORIDADE_MAX || filaRemover(fila, id) != 0) return -1;
+    return filaInserir(fila, id, prioridade);
+}
+
+/*
+ * Retira e devolve o componente de maior prioridade (o mais antigo do balde),
+ * ou FILA_SEM_ID se a fila estiver vazia; se prioridade != NULL, recebe a
+ * prioridade que ele tinha na fila. O(PRIORIDADE_MAX) no pior caso = O(1).
+ */
+uint32_t filaRetirarMaior(FilaPrioridade *fila, int *prioridade) {
+    while (fila->maior >= PRIORIDADE_MIN && fila->cabeca[fila->maior] == FILA_SEM_ID) fila->maior--;
+    if (fila->maior < PRIORIDADE_MIN) return FILA_SEM_ID;
+    uint32_t id = fila->cabeca[fila->maior];
+    if (prioridade) *prioridade = fila->balde[id];
+    filaRemover(fila, id);
+    return id;
+}
+
+/* ---------------- inventário com visões persistentes ---------------- */
+
+void inventarioIniciar(Inventario *inv) {
+    vetorIniciar(&inv->itens);
+    for (int c = 0; c < TOTAL_CRITERIOS; ++c) {
+        visaoIniciar(&inv->visoes[c]);
+        inv->visaoValida[c] = 0;
+    }
+    inv->visaoValida[CRITERIO_NOME] = 1; /* vazia, já está ordenada: inserções a mantêm (ver inventarioAposInsercao) */
+    hashIniciar(&inv->hashNome);
+    inv->hashValido = 1;
+    inv->mapa = NULL;
+    inv->tamanhoMapa = 0;
+    inv->modoColunas = 0;
+    colunasIniciar(&inv->colunas);
+    inv->colunasValidas = 1;
+    visaoIniciar(&inv->visaoComposta);
+    memset(&inv->especComposta, 0, sizeof(inv->especComposta));
+    inv->compostaValida = 0;
+    filaIniciar(&inv->montagem);
+    inv->montagemAtiva = 0;
+    inv->conferenciaPendente = 0;
+}
+
+/* libera o arquivo mapeado (os dados já devem ter sido copiados ou descartados) */
+static void inventarioDesmapear(Inventario *inv) {
+    if (!inv->mapa) return;
+#ifdef USA_MMAP
+    munmap(inv->mapa, inv->tamanhoMapa);
+#else
+    free(inv->mapa);
+#endif
+    inv->mapa = NULL;
+    inv->tamanhoMapa = 0;
+}
+
+void inventarioLiberar(Inventario *inv) {
+    for (int c = 0; c < TOTAL_CRITERIOS; ++c) visaoLiberar(&inv->visoes[c]);
+    visaoLiberar(&inv->visaoComposta);
+    filaLiberar(&inv->montagem);
+    hashLiberar(&inv->hashNome);
+    colunasLiberar(&inv->colunas);
+    vetorLiberar(&inv->itens);
+    inventarioDesmapear(inv);
+    inventarioIniciar(inv);
+}
+
+/* chamar sempre que registros forem inseridos, removidos ou mudarem de posição */
+void inventarioInvalidarVisoes(Inventario *inv) {
+    for (int c = 0; c < TOTAL_CRITERIOS; ++c) inv->visaoValida[c] = 0;
+    inv->compostaValida = 0;
+}
+
+/* descarta todos os componentes (mantém a memória alocada) */
+void inventarioLimpar(Inventario *inv) {
+    vetorLimpar(&inv->itens);
+    inventarioInvalidarVisoes(inv);
+    /* vazia, a visão por nome está trivialmente ordenada: cadastros seguintes a mantêm */
+    inv->visaoValida[CRITERIO_NOME] = (visaoPreparar(&inv->visoes[CRITERIO_NOME], 0) == 0);
+    hashLimpar(&inv->hashNome);
+    inv->hashValido = 1;
+    inv->colunas.total = 0;
+    inv->colunasValidas = 1;
+    inv->montagemAtiva = 0;
+}
+
+/* fonte dos campos para visões, buscas e exibição (colunas só se estiverem em dia) */
+FonteComponentes inventarioFonte(const Inventario *inv) {
+    FonteComponentes f = { inv->itens.dados, NULL };
+    if (inv->modoColunas && inv->colunasValidas) f.colunas = &inv->colunas;
+    return f;
+}
+
+/*
+ * Calcula as chaves e registra no índice hash o componente recém-adicionado em
+ * itens.dados[id]. Se a visão por nome era válida, o componente é inserido na sua
+ * posição ordenada e ela continua válida; as demais visões ficam inválidas.
+ * Retorna a posição do componente na visão por nome, ou -1 se ela ficou inválida.
+ */
+long inventarioAposInsercao(Inventario *inv, size_t id) {
+    VisaoIndices *visaoNome = &inv->visoes[CRITERIO_NOME];
+    int manterNome = inv->visaoValida[CRITERIO_NOME] && visaoNome->total == id;
+    componenteAtualizarChaves(&inv->itens.dados[id]);
+    inventarioInvalidarVisoes(inv);
+    if (inv->modoColunas && inv->colunasValidas
+        && (inv->colunas.total != id || colunasAcrescentar(&inv->colunas, &inv->itens.dados[id]) != 0))
+        inv->colunasValidas = 0;
+    long posicaoNome = -1;
+    if (manterNome) {
+        FonteComponentes f = inventarioFonte(inv);
+        unsigned long long comparacoes = 0;
+        posicaoNome = visaoInserirOrdenado(visaoNome, &f, (uint32_t)id, comparadorDoCriterio(CRITERIO_NOME, &f),
+                                           &comparacoes);
+        inv->visaoValida[CRITERIO_NOME] = (posicaoNome >= 0);
+    }
+    if (inv->montagemAtiva && (id > UINT32_MAX
+                               || filaInserir(&inv->montagem, (uint32_t)id, inv->itens.dados[id].prioridade) != 0))
+        inv->montagemAtiva = 0;
+    if (!inv->hashValido) return posicaoNome; /* será reconstruído na próxima busca */
+    if (id > UINT32_MAX || hashInserir(&inv->hashNome, inv->itens.dados, (uint32_t)id) != 0) inv->hashValido = 0;
+    return posicaoNome;
+}
+
+/* os registros mudaram de posição (ordenação física): visões e hash apontam para posições antigas */
+void inventarioRegistrosMovidos(Inventario *inv) {
+    inventarioInvalidarVisoes(inv);
+    inv->colunasValidas = 0;
+    inv->montagemAtiva = 0; /* a fila guarda IDs (posições) */
+    inv->hashValido = (hashReconstruir(&inv->hashNome, &inv->itens) == 0);
+}
+
+/* garante o índice hash consistente com os registros; retorna 0 em sucesso */
+int inventarioGarantirHash(Inventario *inv) {
+    if (!inv->hashValido) inv->hashValido = (hashReconstruir(&inv->hashNome, &inv->itens) == 0);
+    return inv->hashValido ? 0 : -1;
+}
+
+/* garante as colunas consistentes com os registros (só no modo colunas); 0 em sucesso */
+int inventarioGarantirColunas(Inventario *inv) {
+    if (!inv->modoColunas) return 0;
+    if (!inv->colunasValidas) inv->colunasValidas = (colunasConstruir(&inv->colunas, &inv->itens) == 0);
+    return inv->colunasValidas ? 0 : -1;
+}
+
+/* liga (1) ou desliga (0) o espelho em colunas; desligar libera a memória das colunas */
+int inventarioDefinirColunas(Inventario *inv, int ligar) {
+    if (!ligar) {
+        colunasLiberar(&inv->colunas);
+        inv->modoColunas = 0;
+        inv->colunasValidas = 1;
+        return 0;
+    }
+    if (inv->modoColunas) return 0;
+    inv->modoColunas = 1;
+    inv->colunasValidas = 0;
+    if (inventarioGarantirColunas(inv) != 0) {
+        inventarioDefinirColunas(inv, 0);
+        return -1;
+    }
+    return 0;
+}
+
+/*
+ * Garante que a visão do critério esteja ordenada, ordenando-a só se necessário.
+ * Retorna 1 se ordenou (métricas em comparacoes e tempoSeg), 0 se já era válida, -1 em erro.
+ */
+int inventarioGarantirVisao(Inventario *inv, CriterioOrdenacao criterio,
+                            unsigned long long *comparacoes, double *tempoSeg) {
+    *comparacoes = 0;
+    *tempoSeg = 0.0;
+    if (inv->visaoValida[criterio]) return 0;
+    int r;
+    if (inv->modoColunas) {
+        if (inventarioGarantirColunas(inv) != 0) return -1;
+        r = ordenarVisaoColunas(&inv->colunas, &inv->visoes[criterio], criterio, comparacoes, tempoSeg);
+    } else {
+        r = ordenarVisao(&inv->itens, &inv->visoes[criterio], criterio, comparacoes, tempoSeg);
+    }
+    if (r != 0) return -1;
+    inv->visaoValida[criterio] = 1;
+    return 1;
+}
+
+/*
+ * (Re)inicia a fila de montagem com todos os componentes; enquanto ativa, cada
+ * componente cadastrado entra na fila. Retorna 0 em sucesso, -1 sem memória.
+ */
+int inventarioIniciarMontagem(Inventario *inv) {
+    FilaPrioridade *fila = &inv->montagem;
+    inv->montagemAtiva = 0;
+    filaLimpar(fila);
+    if (filaReservar(fila, inv->itens.total) != 0) return -1;
+    for (size_t id = 0; id < inv->itens.total; ++id)
+        if (filaInserir(fila, (uint32_t)id, inv->itens.dados[id].prioridade) != 0) return -1;
+    inv->montagemAtiva = 1;
+    return 0;
+}
+
+static int especificacoesIguais(const EspecificacaoOrdenacao *a, const EspecificacaoOrdenacao *b) {
+    if (a->total != b->total) return 0;
+    for (int k = 0; k < a->total; ++k)
+        if (a->criterio[k] != b->criterio[k] || a->decrescente[k] != b->decrescente[k]) return 0;
+    return 1;
+}
+
+/*
+ * Garante a visão composta ordenada por esp, reordenando só se a especificação
+ * mudou ou a visão ficou inválida. Mesmo retorno de inventarioGarantirVisao.
+ */
+int inventarioGarantirComposta(Inventario *inv, const EspecificacaoOrdenacao *esp,
+                               unsigned long long *comparacoes, double *tempoSeg) {
+    *comparacoes = 0;
+    *tempoSeg = 0.0;
+    if (inv->compostaValida && especificacoesIguais(&inv->especComposta, esp)) return 0;
+    inv->compostaValida = 0;
+    if (inventarioGarantirColunas(inv) != 0) return -1;
+    FonteComponentes f = inventarioFonte(inv);
+    if (ordenarVisaoComposta(&f, inv->itens.total, &inv->visaoComposta, esp, comparacoes, tempoSeg) != 0) return -1;
+    inv->especComposta = *esp;
+    inv->compostaValida = 1;
+    return 1;
+}
+
+/*
+ * Os registros acabaram de ser ordenados fisicamente por nome: as outras visões
+ * ficam inválidas e a visão por nome passa a ser a identidade (sem reordenar).
+ */
+int inventarioRegistrosOrdenadosPorNome(Inventario *inv) {
+    inventarioRegistrosMovidos(inv);
+    if (visaoPreparar(&inv->visoes[CRITERIO_NOME], inv->itens.total) != 0) return -1;
+    inv->visaoValida[CRITERIO_NOME] = 1;
+    return 0;
+}
+
+/* ---------------- formato binário (mmap) ---------------- */
+
+static uint64_t alinharDeslocamento(uint64_t desloc) {
+    return (desloc + FORMATO_ALINHAMENTO - 1) / FORMATO_ALINHAMENTO * FORMATO_ALINHAMENTO;
+}
+
+/* escreve zeros até o deslocamento 'alvo'; retorna 0 em sucesso */
+static int preencherAte(FILE *f, uint64_t *atual, uint64_t alvo) {
+    static const char zeros[FORMATO_ALINHAMENTO] = {0};
+    size_t falta = (size_t)(alvo - *atual);
+    if (falta > 0 && fwrite(zeros, 1, falta, f) != falta) return -1;
+    *atual = alvo;
+    return 0;
+}
+
+/*
+ * Grava o inventário no formato binário: cabeçalho, registros e as visões
+ * atualmente válidas. Escreve num arquivo temporário e o renomeia no fim, para
+ * não truncar um arquivo que esteja mapeado. Retorna 0 em sucesso, -1 em erro.
+ */
+int salvarInventarioBinario(const Inventario *inv, const char *caminho) {
+    const VetorComponentes *v = &inv->itens;
+    CabecalhoInventario cab;
+    memset(&cab, 0, sizeof(cab));
+    memcpy(cab.magica, FORMATO_MAGICA, sizeof(cab.magica));
+    cab.versao = FORMATO_VERSAO;
+    cab.marcaEndian = FORMATO_MARCA_ENDIAN;
+    cab.tamanhoRegistro = (uint32_t)sizeof(Componente);
+    cab.total = v->total;
+
+    uint64_t desloc = alinharDeslocamento(sizeof(cab));
+    cab.deslocRegistros = desloc;
+    desloc = alinharDeslocamento(desloc + v->total * sizeof(Componente));
+    for (int c = 0; c < TOTAL_CRITERIOS; ++c) {
+        if (!inv->visaoValida[c]) continue;
+        cab.deslocVisoes[c] = desloc;
+        desloc = alinharDeslocamento(desloc + v->total * sizeof(uint32_t));
+    }
+    if (dicionarioTipos.total > UINT32_MAX) return -1;
+    cab.totalTipos = (uint32_t)dicionarioTipos.total;
+    cab.deslocTipos = desloc;
+
+    char temporario[1024];
+    if (snprintf(temporario, sizeof(temporario), "%s.tmp", caminho) >= (int)sizeof(temporario)) return -1;
+    FILE *f = fopen(temporario, "wb");
+    if (!f) return -1;
+    uint64_t atual = 0;
+    int ok = fwrite(&cab, sizeof(cab), 1, f) == 1;
+    atual = sizeof(cab);
+    ok = ok && preencherAte(f, &atual, cab.deslocRegistros) == 0;
+    ok = ok && fwrite(v->dados, sizeof(Componente), v->total, f) == v->total;
+    atual += v->total * sizeof(Componente);
+    for (int c = 0; ok && c < TOTAL_CRITERIOS; ++c) {
+        if (!cab.deslocVisoes[c]) continue;
+        ok = preencherAte(f, &atual, cab.deslocVisoes[c]) == 0
+             && fwrite(inv->visoes[c].indices, sizeof(uint32_t), v->total, f) == v->total;
+        atual += v->total * sizeof(uint32_t);
+    }
+    ok = ok && preencherAte(f, &atual, cab.deslocTipos) == 0
+         && fwrite(dicionarioTipos.texto, MAX_TIPO, cab.totalTipos, f) == cab.totalTipos;
+    if (fclose(f) != 0) ok = 0;
+    if (ok && rename(temporario, caminho) != 0) ok = 0;
+    if (!ok) remove(temporario);
+    return ok ? 0 : -1;
+}
+
+/* traz o arquivo inteiro para a memória: mmap privado (cópia na escrita) ou leitura única */
+static void *mapearArquivo(const char *caminho, size_t *tamanho) {
+#ifdef USA_MMAP
+    int fd = open(caminho, O_RDONLY);
+    if (fd < 0) return NULL;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) { close(fd); return NULL; }
+    void *p = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) return NULL;
+    *tamanho = (size_t)st.st_size;
+    return p;
+#else
+    FILE *f = fopen(caminho, "rb");
+    if (!f) return NULL;
+    long t = (fseek(f, 0, SEEK_END) == 0) ? ftell(f) : -1;
+    void *p = (t > 0 && fseek(f, 0, SEEK_SET) == 0) ? malloc((size_t)t) : NULL;
+    if (p && fread(p, 1, (size_t)t, f) != (size_t)t) { free(p); p = NULL; }
+    fclose(f);
+    if (p) *tamanho = (size_t)t;
+    return p;
+#endif
+}
+
+/*
+ * Traz os tipos gravados no arquivo para o dicionário deste processo. Se os IDs
+ * coincidirem (caso comum: arquivo aberto num processo novo) os registros não são
+ * tocados; senão os tipoId são traduzidos no próprio mapeamento (MAP_PRIVATE,
+ * cópia na escrita). Retorna 0 em sucesso, -1 se faltar memória.
+ */
+static int importarTiposArquivo(const char *textos, uint32_t totalTipos, Componente registros[], size_t total) {
+    uint32_t *traducao = malloc(totalTipos * sizeof(uint32_t));
+    if (!traducao) return -1;
+    int identidade = 1;
+    for (uint32_t t = 0; t < totalTipos; ++t) {
+        traducao[t] = tipoInternar(textos + (size_t)t * MAX_TIPO); /* limitado a MAX_TIPO-1 caracteres */
+        if (traducao[t] == TIPO_INVALIDO) {
+            free(traducao);
+            return -1;
+        }
+        if (traducao[t] != t) identidade = 0;
+    }
+    for (size_t i = 0; !identidade && i < total; ++i) {
+        uint32_t t = registros[i].tipoId;
+        registros[i].tipoId = (t < totalTipos) ? traducao[t] : TIPO_ID_PADRAO;
+    }
+    free(traducao);
+    return 0;
+}
+
+/*
+ * Abre um inventário gravado por salvarInventarioBinario e o usa diretamente
+ * a partir do mapeamento: só o cabeçalho é validado, então o custo não depende
+ * do número de registros. Registros e visões são conferidos no primeiro uso
+ * (inventarioConferir), pois o arquivo pode estar truncado ou editado.
+ * O índice hash é reconstruído sob demanda na primeira busca por hash.
+ * Retorna 0 em sucesso, -1 se o arquivo não puder ser lido e -2 se for inválido.
+ */
+int abrirInventarioBinario(Inventario *inv, const char *caminho) {
+    size_t tamanho = 0;
+    char *mapa = mapearArquivo(caminho, &tamanho);
+    if (!mapa) return -1;
+
+    Inventario novo;
+    inventarioIniciar(&novo);
+    novo.mapa = mapa;
+    novo.tamanhoMapa = tamanho;
+
+    CabecalhoInventario cab;
+    int valido = tamanho >= sizeof(cab);
+    if (valido) memcpy(&cab, mapa, sizeof(cab));
+    valido = valido && memcmp(cab.magica, FORMATO_MAGICA, sizeof(cab.magica)) == 0
+                    && cab.versao == FORMATO_VERSAO
+                    && cab.marcaEndian == FORMATO_MARCA_ENDIAN
+                    && cab.tamanhoRegistro == sizeof(Componente)
+                    && cab.total <= UINT32_MAX
+                    && cab.deslocRegistros % FORMATO_ALINHAMENTO == 0
+                    && cab.deslocRegistros <= tamanho
+                    && cab.total * sizeof(Componente) <= tamanho - cab.deslocRegistros;
+    for (int c = 0; valido && c < TOTAL_CRITERIOS; ++c) {
+        uint64_t d = cab.deslocVisoes[c];
+        if (d == 0) continue;
+        valido = d % FORMATO_ALINHAMENTO == 0 && d <= tamanho && cab.total * sizeof(uint32_t) <= tamanho - d;
+    }
+    valido = valido && cab.totalTipos > 0
+                    && cab.deslocTipos % FORMATO_ALINHAMENTO == 0
+                    && cab.deslocTipos <= tamanho
+                    && (uint64_t)cab.totalTipos * MAX_TIPO <= tamanho - cab.deslocTipos;
+    if (!valido) {
+        inventarioLiberar(&novo);
+        return -2;
+    }
+    if (importarTiposArquivo(mapa + cab.deslocTipos, cab.totalTipos,
+                             (Componente *)(mapa + cab.deslocRegistros), (size_t)cab.total) != 0) {
+        inventarioLiberar(&novo);
+        return -1;
+    }
+
+    novo.itens.dados = (Componente *)(mapa + cab.deslocRegistros);
+    novo.itens.total = novo.itens.capacidade = (size_t)cab.total;
+    novo.itens.externo = 1;
+    for (int c = 0; c < TOTAL_CRITERIOS; ++c) {
+        novo.visaoValida[c] = 0;
+        if (!cab.deslocVisoes[c]) continue;
+        novo.visoes[c].indices = (uint32_t *)(mapa + cab.deslocVisoes[c]);
+        novo.visoes[c].total = (size_t)cab.total;
+        novo.visoes[c].externo = 1;
+        novo.visaoValida[c] = 1;
+    }
+    novo.hashValido = 0;
+    novo.modoColunas = inv->modoColunas;
+    novo.colunasValidas = 0;
+    novo.conferenciaPendente = 1;
+
+    inventarioLiberar(inv);
+    *inv = novo;
+    return 0;
+}
+
+/*
+ * Confere, uma única vez após abrirInventarioBinario, o que serve de índice em
+ * vetores: prioridade fora do intervalo é limitada a ele, tipoId desconhecido vira
+ * TIPO_ID_PADRAO, o nome ganha terminador e uma chaveNome sem terminador ou cujo
+ * prefixoNome não confere é recalculada; uma visão com índice fora do vetor é
+ * descartada. O(n), paga no primeiro comando após a abertura (a abertura segue O(1)).
+ * Retorna quantos registros foram corrigidos; *visoesDescartadas recebe as visões
+ * descartadas (com registros corrigidos, todas: sua ordem pode não valer mais).
+ */
+size_t inventarioConferir(Inventario *inv, int *visoesDescartadas) {
+    *visoesDescartadas = 0;
+    if (!inv->conferenciaPendente) return 0;
+    inv->conferenciaPendente = 0;
+
+    VetorComponentes *v = &inv->itens;
+    size_t corrigidos = 0;
+    for (size_t i = 0; i < v->total; ++i) {
+        Componente *c = &v->dados[i];
+        int corrigido = 0;
+        if (c->prioridade < PRIORIDADE_MIN || c->prioridade > PRIORIDADE_MAX) {
+            c->prioridade = (c->prioridade < PRIORIDADE_MIN) ? PRIORIDADE_MIN : PRIORIDADE_MAX;
+            corrigido = 1;
+        }
+        if (c->tipoId >= dicionarioTipos.total) {
+            c->tipoId = TIPO_ID_PADRAO;
+            corrigido = 1;
+        }
+        if (memchr(c->nome, '\0', MAX_NOME) == NULL) {
+            c->nome[MAX_NOME - 1] = '\0';
+            corrigido = 1;
+        }
+        if (memchr(c->chaveNome, '\0', TAM_CHAVE) == NULL || c->prefixoNome != prefixoChave(c->chaveNome))
+            corrigido = 1;
+        if (corrigido) {
+            componenteAtualizarChaves(c);
+            corrigidos++;
+        }
+    }
+
+    for (int c = 0; c < TOTAL_CRITERIOS; ++c) {
+        if (!inv->visaoValida[c]) continue;
+        const VisaoIndices *visao = &inv->visoes[c];
+        int valida = (corrigidos == 0 && visao->total == v->total);
+        for (size_t i = 0; valida && i < visao->total; ++i) valida = (visao->indices[i] < v->total);
+        if (!valida) {
+            inv->visaoValida[c] = 0;
+            (*visoesDescartadas)++;
+        }
+    }
+    return corrigidos;
+}
+
+/* ---------------- busca binária por nome (após ordenação por nome) ---------------- */
+/*
+ * Busca binária sobre uma visão ordenada por nome, lendo prefixos e chaves da fonte.
+ * Retorna a posição na visão (o registro é o de índice visao->indices[pos]) ou -1,
+ * e preenche comparacoesBusca. Comparação case-insensitive: a chave é convertida uma
+ * vez (com seu prefixo) e comparada com prefixoNome e, em empate, com chaveNome.
+ */
+long buscaBinariaPorNomeVisao(const FonteComponentes *f, const VisaoIndices *visao, const char chave[],
+                              unsigned long long *comparacoesBusca) {
+    size_t left = 0, right = visao->total;
+    *comparacoesBusca = 0;
+    if (strlen(chave) >= MAX_NOME) return -1;
+    char chaveDobrada[TAM_CHAVE];
+    dobrarCaixa(chaveDobrada, chave);
+    uint64_t prefixo = prefixoChave(chaveDobrada);
+    while (left < right) {
+        size_t mid = left + (right - left) / 2;
+        (*comparacoesBusca)++;
+        uint32_t id = visao->indices[mid];
+        int cmp = compararChavePrefixada(fontePrefixoNome(f, id), fonteChaveNome(f, id), prefixo, chaveDobrada);
+        if (cmp == 0) return (long)mid;
+        if (cmp < 0) left = mid + 1;
+        else right = mid;
+    }
+    return -1;
+}
+
+/* como compararChavePrefixada, mas só sobre os 'tamanho' primeiros bytes das chaves */
+static int compararInicioChave(uint64_t prefixoA, const char *a, uint64_t prefixoB, const char *b, size_t tamanho) {
+    if (tamanho == 0) return 0;
+    if (tamanho < 8) {
+        prefixoA >>= 64 - 8 * tamanho;
+        prefixoB >>= 64 - 8 * tamanho;
+    }
+    if (prefixoA != prefixoB) return prefixoA < prefixoB ? -1 : 1;
+    return (tamanho <= 8) ? 0 : memcmp(a + 8, b + 8, tamanho - 8);
+}
+
+/*
+ * Busca por prefixo (sem distinção de caixa) na visão por nome: os nomes que começam
+ * com 'prefixo' são contíguos na visão, e duas buscas binárias (limite inferior e
+ * superior) sobre os primeiros bytes das chaves dão o intervalo [*inicio, *fim).
+ * O(log n) comparações, qualquer que seja o número de resultados.
+ */
+void buscaPrefixoVisao(const FonteComponentes *f, const VisaoIndices *visao, const char *prefixo,
+                       size_t *inicio, size_t *fim, unsigned long long *comparacoes) {
+    *comparacoes = 0;
+    *inicio = *fim = 0;
+    size_t tamanho = strlen(prefixo);
+    if (tamanho >= MAX_NOME) return; /* mais longo que qualquer nome armazenável */
+    char chave[TAM_CHAVE];
+    dobrarCaixa(chave, prefixo);
+    uint64_t prefixoConsulta = prefixoChave(chave);
+
+    for (int superior = 0; superior <= 1; ++superior) {
+        /* inferior: primeira chave com início >= prefixo; superior: primeira com início > prefixo */
+        size_t lo = superior ? *inicio : 0, hi = visao->total;
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            uint32_t id = visao->indices[mid];
+            (*comparacoes)++;
+            int c = compararInicioChave(fontePrefixoNome(f, id), fonteChaveNome(f, id), prefixoConsulta, chave, tamanho);
+            if (c < 0 || (superior && c == 0)) lo = mid + 1;
+            else hi = mid;
+        }
+        if (superior) *fim = lo;
+        else *inicio = lo;
+    }
+}
+
+/* consulta de uma busca em lote: chave já dobrada, com prefixo, e a posição na lista original */
+typedef struct {
+    uint64_t prefixo;
+    char chave[TAM_CHAVE];
+    uint32_t ordem;
+} ConsultaNome;
+
+static _Thread_local unsigned long long comparacoesConsultas; /* qsort não repassa contexto */
+
+static int compararConsultas(const void *pa, const void *pb) {
+    const ConsultaNome *a = pa, *b = pb;
+    comparacoesConsultas++;
+    int c = compararChavePrefixada(a->prefixo, a->chave, b->prefixo, b->chave);
+    return c ? c : (a->ordem > b->ordem) - (a->ordem < b->ordem);
+}
+
+/*
+ * Busca em lote na visão por nome: as m consultas são ordenadas pela chave e
+ * resolvidas em uma única varredura para a frente. De uma consulta à seguinte a
+ * posição avança em saltos exponenciais (galope) e o último salto é fechado por
+ * busca binária, O(m log(n/m)) comparações no total: consultas densas viram uma
+ * intercalação, esparsas custam pouco mais que m buscas binárias.
+ * posicoes[i] recebe a posição de nomes[i] na visão ou -1. Retorna 0, ou -1 sem memória.
+ */
+int buscaLotePorNomeVisao(const FonteComponentes *f, const VisaoIndices *visao, const char *const nomes[], size_t m,
+                          long posicoes[], unsigned long long *comparacoesOrdenacao,
+                          unsigned long long *comparacoesVarredura) {
+    *comparacoesOrdenacao = 0;
+    *comparacoesVarredura = 0;
+    if (m > UINT32_MAX) return -1;
+    ConsultaNome *consultas = malloc((m ? m : 1) * sizeof(ConsultaNome));
+    if (!consultas) return -1;
+
+    size_t validas = 0;
+    for (size_t i = 0; i < m; ++i) {
+        posicoes[i] = -1;
+        if (strlen(nomes[i]) >= MAX_NOME) continue; /* mais longa que qualquer nome armazenável */
+        ConsultaNome *q = &consultas[validas++];
+        dobrarCaixa(q->chave, nomes[i]);
+        q->prefixo = prefixoChave(q->chave);
+        q->ordem = (uint32_t)i;
+    }
+    comparacoesConsultas = 0;
+    qsort(consultas, validas, sizeof(ConsultaNome), compararConsultas);
+    *comparacoesOrdenacao = comparacoesConsultas;
+
+    const uint32_t *idx = visao->indices;
+    size_t n = visao->total, pos = 0;
+    for (size_t i = 0; i < validas; ++i) {
+        const ConsultaNome *q = &consultas[i];
+        /* galope: [lo, hi) contém a primeira posição com chave >= q */
+        size_t lo = pos, hi = pos, passo = 1;
+        while (hi < n) {
+            (*comparacoesVarredura)++;
+            if (compararChavePrefixada(fontePrefixoNome(f, idx[hi]), fonteChaveNome(f, idx[hi]), q->prefixo, q->chave) >= 0)
+                break;
+            lo = hi + 1;
+            hi = (n - hi > passo) ? hi + passo : n;
+            passo *= 2;
+        }
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            (*comparacoesVarredura)++;
+            if (compararChavePrefixada(fontePrefixoNome(f, idx[mid]), fonteChaveNome(f, idx[mid]), q->prefixo, q->chave) < 0)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        pos = lo;
+        if (pos < n) {
+            (*comparacoesVarredura)++;
+            if (compararChavePrefixada(fontePrefixoNome(f, idx[pos]), fonteChaveNome(f, idx[pos]), q->prefixo, q->chave) == 0)
+                posicoes[q->ordem] = (long)pos;
+        }
+    }
+    free(consultas);
+    return 0;
+}
+
+/* ---------------- entrada de dados ---------------- */
+
+/*
+ * Cadastra componentes pelo teclado, substituindo os atuais ou acrescentando a eles.
+ * Cada novo componente entra direto na sua posição da visão por nome (se válida),
+ * de modo que a busca binária seguinte não precisa reordenar.
+ */
+void cadastrarComponentes(Inventario *inv, int substituir) {
+    VetorComponentes *v = &inv->itens;
+    char buffer[128];
+    long quantidade;
+    if (substituir) inventarioLimpar(inv);
+
+    printf("\nQuantos componentes deseja cadastrar? (>= 1): ");
+    if (fgets(buffer, sizeof(buffer), stdin) == NULL) return;
+    if (sscanf(buffer, "%ld", &quantidade) != 1 || quantidade < 1) {
+        printf("Entrada inválida. Abortando cadastro.\n");
+        return;
+    }
+    if (vetorReservar(v, v->total + (size_t)quantidade) != 0) {
+        printf("Memória insuficiente para %ld componentes. Abortando cadastro.\n", quantidade);
+        return;
+    }
+
+    long cadastrados = 0;
+    int fimEntrada = 0;
+    for (long i = 0; i < quantidade && !fimEntrada; ++i) {
+        Componente *arr = vetorAdicionar(v);
+        printf("\n--- Componente %ld ---\n", i+1);
+
+        printf("Nome: ");
+        if (fgets(arr->nome, MAX_NOME, stdin) == NULL) {
+            fimEntrada = 1;
+            break;
+        }
+        trim_newline(arr->nome);
+        if (strlen(arr->nome) == 0) {
+            strncpy(arr->nome, NOME_PADRAO, MAX_NOME-1);
+            arr->nome[MAX_NOME-1] = '\0';
+        }
+
+        printf("Tipo (ex: controle, suporte, propulsao): ");
+        char tipo[MAX_TIPO];
+        if (fgets(tipo, MAX_TIPO, stdin) == NULL) {
+            fimEntrada = 1;
+            break;
+        }
+        trim_newline(tipo);
+        if (componenteDefinirTipo(arr, tipo) != 0) {
+            printf("Memória insuficiente para um novo tipo; usando %s.\n", TIPO_PADRAO);
+            arr->tipoId = TIPO_ID_PADRAO;
+        }
+
+        int prio = -1;
+        do {
+            printf("Prioridade (1-10): ");
+            if (fgets(buffer, sizeof(buffer), stdin) == NULL) {
+                fimEntrada = 1;
+                break;
+            }
+            if (sscanf(buffer, "%d", &prio) != 1 || prio < PRIORIDADE_MIN || prio > PRIORIDADE_MAX) {
+                printf("Valor inválido. Tente novamente.\n");
+                prio = -1;
+            }
+        } while (prio == -1);
+        if (fimEntrada) break;
+        arr->prioridade = prio;
+        inventarioAposInsercao(inv, v->total - 1);
+        cadastrados++;
+    }
+    if (fimEntrada) {
+        v->total--; /* descarta o componente incompleto */
+        printf("\nFim da entrada: cadastro interrompido após %ld de %ld componentes.\n", cadastrados, quantidade);
+    }
+    printf("\nCadastro concluído: %zu componentes%s.\n", v->total,
+           inv->visaoValida[CRITERIO_NOME] ? " (visão por NOME mantida em ordem)" : "");
+}
+
+/* ---------------- carga em lote (CSV/TSV) ---------------- */
+
+/* remove espaços e aspas envolventes de um campo, in-place; devolve o início do campo */
+static char *limparCampo(char *ini, char *fim) {
+    while (ini < fim && isspace((unsigned char)*ini)) ini++;
+    while (fim > ini && isspace((unsigned char)fim[-1])) fim--;
+    if (fim - ini >= 2 && *ini == '"' && fim[-1] == '"') { ini++; fim--; }
+    *fim = '\0';
+    return ini;
+}
+
+/* copia campo truncando em cap-1 bytes; campo vazio recebe o valor padrão */
+static void copiarCampo(char *dst, size_t cap, const char *campo, const char *padrao) {
+    const char *origem = (*campo != '\0') ? campo : padrao;
+    size_t len = strlen(origem);
+    if (len >= cap) len = cap - 1;
+    memcpy(dst, origem, len);
+    dst[len] = '\0';
+}
+
+/* separador: TAB se a primeira linha tiver TAB, senão ';' se tiver ';', senão ',' */
+static char detectarSeparador(const char *linha, const char *fim) {
+    const char *nl = memchr(linha, '\n', (size_t)(fim - linha));
+    size_t len = (size_t)((nl ? nl : fim) - linha);
+    if (memchr(linha, '\t', len)) return '\t';
+    if (memchr(linha, ';', len)) return ';';
+    return ',';
+}
+
+/*
+ * Carrega componentes de um arquivo delimitado (nome, tipo, prioridade por linha),
+ * acrescentando-os ao inventário. O arquivo é lido com um único fread para um buffer
+ * e analisado in-place. Uma linha de cabeçalho iniciada por "nome" é ignorada.
+ * Aplica os mesmos padrões do cadastro (NOME_PADRAO, TIPO_PADRAO); linhas com
+ * prioridade ausente ou fora de PRIORIDADE_MIN..PRIORIDADE_MAX são rejeitadas.
+ * Retorna o número de componentes carregados, ou -1 se o arquivo não puder ser lido.
+ */
+long carregarArquivoDelimitado(Inventario *inv, const char *caminho, size_t *rejeitadas) {
+    *rejeitadas = 0;
+    FILE *f = fopen(caminho, "rb");
+    if (!f) return -1;
+
+    if (fseek(f, 0, SEEK_END) != 0) { fclose(f); return -1; }
+    long tamanho = ftell(f);
+    if (tamanho < 0 || fseek(f, 0, SEEK_SET) != 0) { fclose(f); return -1; }
+
+    char *buf = malloc((size_t)tamanho + 1);
+    if (!buf) { fclose(f); return -1; }
+    size_t lidos = fread(buf, 1, (size_t)tamanho, f);
+    fclose(f);
+    if (lidos != (size_t)tamanho) { free(buf); return -1; }
+    char *fim = buf + lidos;
+    *fim = '\0';
+
+    /* reserva de uma vez: no máximo uma linha por '\n' (+1 sem '\n' final) */
+    size_t linhas = 1;
+    for (const char *p = buf; (p = memchr(p, '\n', (size_t)(fim - p))) != NULL; ++p) linhas++;
+    VetorComponentes *v = &inv->itens;
+    if (vetorReservar(v, v->total + linhas) != 0) { free(buf); return -1; }
+    /* só agora, com o arquivo lido: em lote, uma ordenação ao final custa menos que uma inserção ordenada por linha */
+    inventarioInvalidarVisoes(inv);
+
+    char sep = detectarSeparador(buf, fim);
+    long carregados = 0;
+    int primeira = 1;
+    char *linha = buf;
+    while (linha < fim) {
+        char *nl = memchr(linha, '\n', (size_t)(fim - linha));
+        char *fimLinha = nl ? nl : fim;
+        char *proxima = nl ? nl + 1 : fim;
+        if (fimLinha > linha && fimLinha[-1] == '\r') fimLinha--;
+
+        /* divide em até 3 campos */
+        char *campos[3] = { fimLinha, fimLinha, fimLinha };
+        char *fimCampos[3] = { fimLinha, fimLinha, fimLinha };
+        int nCampos = 0;
+        char *p = linha;
+        while (nCampos < 3) {
+            char *d = memchr(p, sep, (size_t)(fimLinha - p));
+            campos[nCampos] = p;
+            fimCampos[nCampos] = d ? d : fimLinha;
+            nCampos++;
+            if (!d) break;
+            p = d + 1;
+        }
+        for (int c = 0; c < nCampos; ++c) campos[c] = limparCampo(campos[c], fimCampos[c]);
+
+        if (nCampos == 1 && campos[0][0] == '\0') {
+            /* linha em branco */
+        } else if (primeira && stricmp_local(campos[0], "nome") == 0) {
+            /* cabeçalho */
+        } else {
+            char *resto;
+            long prio = (nCampos == 3) ? strtol(campos[2], &resto, 10) : 0;
+            if (nCampos < 3 || resto == campos[2] || *resto != '\0' || prio < PRIORIDADE_MIN || prio > PRIORIDADE_MAX) {
+                (*rejeitadas)++;
+            } else {
+                Componente *c = vetorAdicionar(v);
+                copiarCampo(c->nome, MAX_NOME, campos[0], NOME_PADRAO);
+                c->prioridade = (int)prio;
+                if (componenteDefinirTipo(c, campos[1]) != 0) {
+                    v->total--; /* sem memória para um tipo novo */
+                    (*rejeitadas)++;
+                } else {
+                    inventarioAposInsercao(inv, v->total - 1);
+                    carregados++;
+                }
+            }
+        }
+        primeira = 0;
+        linha = proxima;
+    }
+
+    free(buf);
+    return carregados;
+}
+
+/* ---------------- contadores de hardware (perf_event_open) ---------------- */
+
+typedef enum {
+    HW_CICLOS,
+    HW_INSTRUCOES,
+    HW_FALHAS_DESVIO,
+    HW_FALHAS_L1D,
+    HW_FALHAS_LLC,
+    TOTAL_CONTADORES_HW
+} ContadorHw;
+
+static const char *NOMES_CONTADOR_HW[TOTAL_CONTADORES_HW] = {
+    "ciclos", "instruções", "falhas de desvio", "falhas L1d", "falhas LLC"
+};
+
+/* um descritor por contador: cada um pode estar indisponível de forma independente */
+typedef struct {
+    int fd[TOTAL_CONTADORES_HW];
+    unsigned long long valor[TOTAL_CONTADORES_HW];
+    int ativo; /* coleta ligada pelo usuário e ao menos um contador aberto */
+} ContadoresHw;
+
+/* contadores da sessão (menu ou lote), ligados pela opção 13 / comando "perf on" */
+static ContadoresHw contadoresSessao = {
+    { -1, -1, -1, -1, -1 }, { 0, 0, 0, 0, 0 }, 0
+};
+
+#ifdef USA_PERF_EVENT
+static int abrirContadorHw(uint32_t tipo, uint64_t config) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = tipo;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1; /* funciona com perf_event_paranoid <= 2 */
+    attr.exclude_hv = 1;
+    /*
+     * herdado pelas threads criadas depois (ordenações paralelas): a contagem de cada
+     * thread é somada à do contador ao fim dela, antes do pthread_join retornar
+     */
+    attr.inherit = 1;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+#endif
+
+/* fecha todos os contadores e desliga a coleta */
+void contadoresHwDesligar(ContadoresHw *c) {
+    for (int i = 0; i < TOTAL_CONTADORES_HW; ++i) {
+#ifdef USA_PERF_EVENT
+        if (c->fd[i] >= 0) close(c->fd[i]);
+#endif
+        c->fd[i] = -1;
+    }
+    c->ativo = 0;
+}
+
+/* abre os contadores disponíveis; retorna quantos abriram (0 = sem suporte ou sem permissão) */
+int contadoresHwLigar(ContadoresHw *c) {
+    contadoresHwDesligar(c);
+    int abertos = 0;
+#ifdef USA_PERF_EVENT
+    const uint64_t l1dLeituraFalha = PERF_COUNT_HW_CACHE_L1D
+                                   | ((uint64_t)PERF_COUNT_HW_CACHE_OP_READ << 8)
+                                   | ((uint64_t)PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    c->fd[HW_CICLOS] = abrirContadorHw(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    c->fd[HW_INSTRUCOES] = abrirContadorHw(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    c->fd[HW_FALHAS_DESVIO] = abrirContadorHw(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+    c->fd[HW_FALHAS_L1D] = abrirContadorHw(PERF_TYPE_HW_CACHE, l1dLeituraFalha);
+    c->fd[HW_FALHAS_LLC] = abrirContadorHw(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+    for (int i = 0; i < TOTAL_CONTADORES_HW; ++i) {
+        if (c->fd[i] >= 0) abertos++;
+        else c->fd[i] = -1;
+    }
+#endif
+    c->ativo = abertos > 0;
+    return abertos;
+}
+
+/* zera e inicia a contagem (sem efeito se a coleta estiver desligada) */
+void contadoresHwComecar(ContadoresHw *c) {
+    if (!c->ativo) return;
+#ifdef USA_PERF_EVENT
+    for (int i = 0; i < TOTAL_CONTADORES_HW; ++i) {
+        if (c->fd[i] < 0) continue;
+        ioctl(c->fd[i], PERF_EVENT_IOC_RESET, 0);
+        ioctl(c->fd[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+/* interrompe a contagem e lê os valores */
+void contadoresHwParar(ContadoresHw *c) {
+    if (!c->ativo) return;
+#ifdef USA_PERF_EVENT
+    for (int i = 0; i < TOTAL_CONTADORES_HW; ++i) {
+        c->valor[i] = 0;
+        if (c->fd[i] < 0) continue;
+        ioctl(c->fd[i], PERF_EVENT_IOC_DISABLE, 0);
+        uint64_t v = 0;
+        if (read(c->fd[i], &v, sizeof(v)) == (ssize_t)sizeof(v)) c->valor[i] = v;
+    }
+#endif
+}
+
+/* exibe a última contagem na linha seguinte às métricas da operação; contador indisponível = n/d */
+void mostrarContadoresHw(const ContadoresHw *c) {
+    if (!c->ativo) return;
+    printf("Contadores HW:");
+    for (int i = 0; i < TOTAL_CONTADORES_HW; ++i) {
+        if (c->fd[i] >= 0) printf(" %s = %llu%s", NOMES_CONTADOR_HW[i], c->valor[i], i + 1 < TOTAL_CONTADORES_HW ? " |" : "");
+        else printf(" %s = n/d%s", NOMES_CONTADOR_HW[i], i + 1 < TOTAL_CONTADORES_HW ? " |" : "");
+    }
+    if (c->fd[HW_CICLOS] >= 0 && c->fd[HW_INSTRUCOES] >= 0 && c->valor[HW_CICLOS] > 0)
+        printf(" | IPC = %.2f", (double)c->valor[HW_INSTRUCOES] / (double)c->valor[HW_CICLOS]);
+    printf("\n");
+}
+
+/* liga/desliga a coleta da sessão e informa o resultado; retorna 0 se o estado pedido foi atingido */
+int alternarContadoresHw(int ligar) {
+    if (!ligar) {
+        contadoresHwDesligar(&contadoresSessao);
+        printf("Contadores de hardware desligados.\n");
+        return 0;
+    }
+    int abertos = contadoresHwLigar(&contadoresSessao);
+    if (abertos == 0) {
+        printf("Contadores de hardware indisponíveis (sem suporte no sistema ou bloqueados por perf_event_paranoid).\n");
+        return -1;
+    }
+    printf("Contadores de hardware ligados (%d de %d disponíveis).\n", abertos, TOTAL_CONTADORES_HW);
+    return 0;
+}
+
+/* ---------------- medição de tempo com repetições ---------------- */
+
+/* adaptadores: todas as ordenações com a mesma assinatura (registros em v, visão sobre v ou sobre col) */
+typedef int (*FuncaoOrdenacao)(VetorComponentes *v, const ColunasComponentes *col, VisaoIndices *visao,
+                               unsigned long long *comparacoes, double *tempoSeg);
+
+static int algBubble(VetorComponentes *v, const ColunasComponentes *col, VisaoIndices *visao, unsigned long long *c, double *t) {
+    (void)col; (void)visao; bubbleSortNome(v, c, t); return 0;
+}
+static int algMerge(VetorComponentes *v, const ColunasComponentes *col, VisaoIndices *visao, unsigned long long *c, double *t) {
+    (void)col; (void)visao; return mergeSortNome(v, c, t);
+}
+static int algMergeParalelo(VetorComponentes *v, const ColunasComponentes *col, VisaoIndices *visao, unsigned long long *c, double *t) {
+    int threads;
+    (void)col; (void)visao; return mergeSortNomeParalelo(v, 0, c, t, NULL, &threads);
+}
+static int algInsertion(VetorComponentes *v, const ColunasComponentes *col, VisaoIndices *visao, unsigned long long *c, double *t) {
+    (void)col; (void)visao; insertionSortTipo(v, c, t); return 0;
+}
+static int algBucketsTipo(VetorComponentes *v, const ColunasComponentes *col, VisaoIndices *visao, unsigned long long *c, double *t) {
+    int threads;
+    (void)col; (void)visao; return bucketSortParalelo(v, CRITERIO_TIPO, c, t, NULL, &threads);
+}
+static int algBucketsPrioridade(VetorComponentes *v, const ColunasComponentes *col, VisaoIndices *visao, unsigned long long *c, double *t) {
+    int threads;
+    (void)col; (void)visao; return bucketSortParalelo(v, CRITERIO_PRIORIDADE, c, t, NULL, &threads);
+}
+static int algSelection(VetorComponentes *v, const ColunasComponentes *col, VisaoIndices *visao, unsigned long long *c, double *t) {
+    (void)col; (void)visao; selectionSortPrioridade(v, c, t); return 0;
+}
+static int algCounting(VetorComponentes *v, const ColunasComponentes *col, VisaoIndices *visao, unsigned long long *c, double *t) {
+    (void)col; (void)visao; return countingSortPrioridade(v, c, t);
+}
+static int algVisaoNome(VetorComponentes *v, const ColunasComponentes *col, VisaoIndices *visao, unsigned long long *c, double *t) {
+    (void)col; return ordenarVisao(v, visao, CRITERIO_NOME, c, t);
+}
+static int algVisaoTipo(VetorComponentes *v, const ColunasComponentes *col, VisaoIndices *visao, unsigned long long *c, double *t) {
+    (void)col; return ordenarVisao(v, visao, CRITERIO_TIPO, c, t);
+}
+static int algVisaoPrioridade(VetorComponentes *v, const ColunasComponentes *col, VisaoIndices *visao, unsigned long long *c, double *t) {
+    (void)col; return ordenarVisao(v, visao, CRITERIO_PRIORIDADE, c, t);
+}
+static int algColunasNome(VetorComponentes *v, const ColunasComponentes *col, VisaoIndices *visao, unsigned long long *c, double *t) {
+    (void)v; return ordenarVisaoColunas(col, visao, CRITERIO_NOME, c, t);
+}
+static int algColunasTipo(VetorComponentes *v, const ColunasComponentes *col, VisaoIndices *visao, unsigned long long *c, double *t) {
+    (void)v; return ordenarVisaoColunas(col, visao, CRITERIO_TIPO, c, t);
+}
+static int algColunasPrioridade(VetorComponentes *v, const ColunasComponentes *col, VisaoIndices *visao, unsigned long long *c, double *t) {
+    (void)v; return ordenarVisaoColunas(col, visao, CRITERIO_PRIORIDADE, c, t);
+}
+
+typedef struct {
+    const char *nome;
+    CriterioOrdenacao criterio;
+    int quadratico; /* O(n^2): o benchmark limita a BENCH_LIMITE_QUADRATICO */
+    int usaColunas; /* ordena uma visão sobre as colunas (SoA) construídas a partir dos registros */
+    FuncaoOrdenacao executar;
+} AlgoritmoOrdenacao;
+
+static const AlgoritmoOrdenacao ALGORITMOS_ORDENACAO[] = {
+    { "bubble",           CRITERIO_NOME,       1, 0, algBubble },
+    { "merge",            CRITERIO_NOME,       0, 0, algMerge },
+    { "paralelo",         CRITERIO_NOME,       0, 0, algMergeParalelo },
+    { "insertion",        CRITERIO_TIPO,       1, 0, algInsertion },
+    { "buckets",          CRITERIO_TIPO,       0, 0, algBucketsTipo },
+    { "selection",        CRITERIO_PRIORIDADE, 1, 0, algSelection },
+    { "counting",         CRITERIO_PRIORIDADE, 0, 0, algCounting },
+    { "buckets",          CRITERIO_PRIORIDADE, 0, 0, algBucketsPrioridade },
+    { "visao",            CRITERIO_NOME,       0, 0, algVisaoNome },
+    { "visao",            CRITERIO_TIPO,       0, 0, algVisaoTipo },
+    { "visao",            CRITERIO_PRIORIDADE, 0, 0, algVisaoPrioridade },
+    { "colunas",          CRITERIO_NOME,       0, 1, algColunasNome },
+    { "colunas",          CRITERIO_TIPO,       0, 1, algColunasTipo },
+    { "colunas",          CRITERIO_PRIORIDADE, 0, 1, algColunasPrioridade },
+};
+#define TOTAL_ALGORITMOS (sizeof(ALGORITMOS_ORDENACAO) / sizeof(ALGORITMOS_ORDENACAO[0]))
+
+/* estatísticas de N repetições de uma operação (tempos em segundos) */
+typedef struct {
+    size_t repeticoes;
+    double minimo;
+    double mediana;
+    double p99;
+    double media;
+    unsigned long long ciclosMediana; /* TSC; 0 se indisponível */
+} EstatisticasTempo;
+
+static int compararDouble(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static int compararCiclos(const void *a, const void *b) {
+    unsigned long long x = *(const unsigned long long *)a, y = *(const unsigned long long *)b;
+    return (x > y) - (x < y);
+}
+
+/* ordena as amostras e preenche as estatísticas (percentil pelo método nearest-rank) */
+static void calcularEstatisticas(double tempos[], unsigned long long ciclos[], size_t n, EstatisticasTempo *est) {
+    qsort(tempos, n, sizeof(double), compararDouble);
+    qsort(ciclos, n, sizeof(unsigned long long), compararCiclos);
+    double soma = 0.0;
+    for (size_t i = 0; i < n; ++i) soma += tempos[i];
+    size_t rank99 = (n * 99 + 99) / 100; /* ceil(0,99 n) */
+    est->repeticoes = n;
+    est->minimo = tempos[0];
+    est->mediana = tempos[(n - 1) / 2];
+    est->p99 = tempos[rank99 - 1];
+    est->media = soma / (double)n;
+    est->ciclosMediana = ciclos[(n - 1) / 2];
+}
+
+/* busca o algoritmo pelo nome e critério na tabela ALGORITMOS_ORDENACAO */
+const AlgoritmoOrdenacao *algoritmoPorNome(const char *nome, CriterioOrdenacao criterio) {
+    for (size_t a = 0; a < TOTAL_ALGORITMOS; ++a) {
+        if (ALGORITMOS_ORDENACAO[a].criterio == criterio && strcmp(ALGORITMOS_ORDENACAO[a].nome, nome) == 0)
+            return &ALGORITMOS_ORDENACAO[a];
+    }
+    return NULL;
+}
+
+/*
+ * Executa a ordenação 'repeticoes' vezes, cada uma sobre uma cópia nova de base
+ * (copiarComponentes), medindo cada execução inteira (inclusive buffers auxiliares).
+ * Para ordenações sobre colunas, as colunas são construídas uma vez, fora da medição.
+ * Comparações e movimentos da última execução vão para comparacoes e movimentos.
+ * Retorna 0 em sucesso, -1 se faltar memória.
+ */
+int medirOrdenacao(const AlgoritmoOrdenacao *alg, const VetorComponentes *base, size_t repeticoes,
+                   EstatisticasTempo *est, unsigned long long *comparacoes, unsigned long long *movimentos) {
+    if (repeticoes == 0) repeticoes = 1;
+    double *tempos = malloc(repeticoes * sizeof(double));
+    unsigned long long *ciclos = malloc(repeticoes * sizeof(unsigned long long));
+    VetorComponentes trabalho;
+    VisaoIndices visao;
+    ColunasComponentes colunas;
+    vetorIniciar(&trabalho);
+    visaoIniciar(&visao);
+    colunasIniciar(&colunas);
+    int r = (tempos && ciclos) ? 0 : -1;
+    if (r == 0 && alg->usaColunas) r = colunasConstruir(&colunas, base);
+
+    for (size_t i = 0; i < repeticoes && r == 0; ++i) {
+        if (copiarComponentes(base, &trabalho) != 0) { r = -1; break; }
+        double tInterno = 0.0;
+        double t0 = relogioSeg();
+        unsigned long long c0 = LER_CICLOS();
+        r = alg->executar(&trabalho, &colunas, &visao, comparacoes, &tInterno);
+        unsigned long long c1 = LER_CICLOS();
+        double t1 = relogioSeg();
+        tempos[i] = t1 - t0;
+        ciclos[i] = c1 - c0;
+    }
+    if (r == 0) {
+        *movimentos = movimentosOrdenacao;
+        calcularEstatisticas(tempos, ciclos, repeticoes, est);
+    }
+
+    colunasLiberar(&colunas);
+    visaoLiberar(&visao);
+    vetorLiberar(&trabalho);
+    free(ciclos);
+    free(tempos);
+    return r;
+}
+
+/*
+ * Repete a busca binária na visão por nome (que deve estar válida) e mede cada execução.
+ * Retorna a posição encontrada (ou -1) e as comparações de uma busca em *comparacoes.
+ */
+long medirBuscaBinaria(const Inventario *inv, const char *chave, size_t repeticoes,
+                       EstatisticasTempo *est, unsigned long long *comparacoes) {
+    if (repeticoes == 0) repeticoes = 1;
+    double *tempos = malloc(repeticoes * sizeof(double));
+    unsigned long long *ciclos = malloc(repeticoes * sizeof(unsigned long long));
+    long pos = -1;
+    FonteComponentes f = inventarioFonte(inv);
+    if (!tempos || !ciclos) {
+        free(tempos);
+        free(ciclos);
+        est->repeticoes = 0;
+        return buscaBinariaPorNomeVisao(&f, &inv->visoes[CRITERIO_NOME], chave, comparacoes);
+    }
+    for (size_t i = 0; i < repeticoes; ++i) {
+        double t0 = relogioSeg();
+        unsigned long long c0 = LER_CICLOS();
+        pos = buscaBinariaPorNomeVisao(&f, &inv->visoes[CRITERIO_NOME], chave, comparacoes);
+        unsigned long long c1 = LER_CICLOS();
+        double t1 = relogioSeg();
+        tempos[i] = t1 - t0;
+        ciclos[i] = c1 - c0;
+    }
+    calcularEstatisticas(tempos, ciclos, repeticoes, est);
+    free(ciclos);
+    free(tempos);
+    return pos;
+}
+
+void mostrarEstatisticas(const EstatisticasTempo *est) {
+    printf("Tempo (%zu repetições): mín = %.9f s | mediana = %.9f s | p99 = %.9f s | média = %.9f s",
+           est->repeticoes, est->minimo, est->mediana, est->p99, est->media);
+    if (est->ciclosMediana) printf(" | ciclos (mediana) = %llu", est->ciclosMediana);
+    printf("\n");
+}
+
+/* ---------------- menu e fluxo ---------------- */
+
+/* confere o inventário aberto de arquivo (se ainda pendente) e avisa se algo foi corrigido */
+static void conferirInventario(Inventario *inv) {
+    int visoesDescartadas = 0;
+    size_t corrigidos = inventarioConferir(inv, &visoesDescartadas);
+    if (corrigidos > 0 || visoesDescartadas > 0)
+        printf("Aviso: arquivo inconsistente: %zu registros corrigidos, %d visões descartadas (serão reordenadas).\n",
+               corrigidos, visoesDescartadas);
+}
+
+/* lê um inteiro (algoritmo, quantidade, prioridade...); entrada vazia ou inválida devolve 'padrao' */
+int lerInteiro(int padrao) {
+    char buf[32];
+    int valor;
+    if (fgets(buf, sizeof(buf), stdin) == NULL) return padrao;
+    if (sscanf(buf, "%d", &valor) != 1) return padrao;
+    return valor;
+}
+
+/* tempo de trabalho de cada thread de uma ordenação paralela */
+static void mostrarTemposThreads(const double temposThread[], int threads) {
+    for (int t = 0; t < threads; ++t) printf("  thread %2d: tempo de trabalho = %.9f s\n", t, temposThread[t]);
+}
+
+/* bucket sort paralelo por tipo ou prioridade com exibição das métricas; retorna 0 em sucesso */
+static int executarBucketSortParalelo(VetorComponentes *v, CriterioOrdenacao criterio) {
+    unsigned long long comps = 0;
+    double tsec = 0.0;
+    double temposThread[MAX_THREADS];
+    int threads = 1;
+    contadoresHwComecar(&contadoresSessao);
+    int r = bucketSortParalelo(v, criterio, &comps, &tsec, temposThread, &threads);
+    contadoresHwParar(&contadoresSessao);
+    if (r != 0) {
+        printf("Memória insuficiente para o Bucket Sort paralelo.\n");
+        return -1;
+    }
+    printf("\nBucket Sort paralelo por %s concluído (%d threads): comparações = %llu, tempo = %.9f s\n",
+           criterio == CRITERIO_TIPO ? "TIPO" : "PRIORIDADE", threads, comps, tsec);
+    mostrarTemposThreads(temposThread, threads);
+    mostrarContadoresHw(&contadoresSessao);
+    return 0;
+}
+
+/*
+ * Ordena por nome com o algoritmo escolhido (1 = Bubble Sort, 2 = Merge Sort,
+ * 3 = Merge Sort paralelo) e exibe as métricas. Retorna 0 em sucesso.
+ */
+int ordenarPorNome(VetorComponentes *v, int algoritmo) {
+    unsigned long long comps = 0;
+    double tsec = 0.0;
+    if (algoritmo == 1) {
+        contadoresHwComecar(&contadoresSessao);
+        bubbleSortNome(v, &comps, &tsec);
+        contadoresHwParar(&contadoresSessao);
+        printf("\nBubble Sort por NOME concluído: comparações = %llu, tempo = %.9f s\n", comps, tsec);
+    } else if (algoritmo == 2) {
+        contadoresHwComecar(&contadoresSessao);
+        int r = mergeSortNome(v, &comps, &tsec);
+        contadoresHwParar(&contadoresSessao);
+        if (r != 0) {
+            printf("Memória insuficiente para o Merge Sort.\n");
+            return -1;
+        }
+        printf("\nMerge Sort por NOME concluído: comparações = %llu, tempo = %.9f s\n", comps, tsec);
+    } else if (algoritmo == 3) {
+        double temposThread[MAX_THREADS];
+        int threads = 1;
+        contadoresHwComecar(&contadoresSessao);
+        int r = mergeSortNomeParalelo(v, 0, &comps, &tsec, temposThread, &threads);
+        contadoresHwParar(&contadoresSessao);
+        if (r != 0) {
+            printf("Memória insuficiente para o Merge Sort paralelo.\n");
+            return -1;
+        }
+        printf("\nMerge Sort paralelo por NOME concluído (%d threads): comparações = %llu, tempo = %.9f s\n",
+               threads, comps, tsec);
+        mostrarTemposThreads(temposThread, threads);
+    } else {
+        printf("Algoritmo inválido.\n");
+        return -1;
+    }
+    mostrarContadoresHw(&contadoresSessao);
+    return 0;
+}
+
+static const char *NOMES_CRITERIO[TOTAL_CRITERIOS] = { "NOME", "TIPO", "PRIORIDADE" };
+
+static int criterioPorNome(const char *nome, CriterioOrdenacao *criterio) {
+    for (int c = 0; c < TOTAL_CRITERIOS; ++c) {
+        if (stricmp_local(nome, NOMES_CRITERIO[c]) == 0) {
+            *criterio = (CriterioOrdenacao)c;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+/*
+ * Lê uma especificação composta: chaves separadas por espaço ou vírgula, cada uma
+ * "criterio[:asc|:desc]" (ex.: "tipo prioridade:desc nome"). Sem sufixo, nome e tipo
+ * são crescentes e prioridade decrescente, como nas ordenações simples.
+ * Altera 'texto'. Retorna 0 em sucesso, -1 (com mensagem) se inválida.
+ */
+static int lerEspecificacaoOrdenacao(char *texto, EspecificacaoOrdenacao *esp) {
+    memset(esp, 0, sizeof(*esp));
+    for (char *chave = strtok(texto, " \t,"); chave; chave = strtok(NULL, " \t,")) {
+        char *sentido = strchr(chave, ':');
+        if (sentido) *sentido++ = '\0';
+        CriterioOrdenacao criterio;
+        if (criterioPorNome(chave, &criterio) != 0) {
+            printf("Chave '%s' inválida: use nome, tipo ou prioridade.\n", chave);
+            return -1;
+        }
+        for (int k = 0; k < esp->total; ++k) {
+            if (esp->criterio[k] == criterio) {
+                printf("Chave %s repetida.\n", NOMES_CRITERIO[criterio]);
+                return -1;
+            }
+        }
+        int decrescente = (criterio == CRITERIO_PRIORIDADE);
+        if (sentido && stricmp_local(sentido, "asc") == 0) {
+            decrescente = 0;
+        } else if (sentido && stricmp_local(sentido, "desc") == 0) {
+            decrescente = 1;
+        } else if (sentido) {
+            printf("Sentido '%s' inválido: use asc ou desc.\n", sentido);
+            return -1;
+        }
+        esp->criterio[esp->total] = criterio;
+        esp->decrescente[esp->total] = decrescente;
+        esp->total++;
+    }
+    if (esp->total == 0) {
+        printf("Informe ao menos uma chave (nome, tipo ou prioridade).\n");
+        return -1;
+    }
+    return 0;
+}
+
+/* escreve a especificação como "TIPO asc, PRIORIDADE desc, NOME asc" */
+static void descreverEspecificacao(const EspecificacaoOrdenacao *esp, char *buf, size_t tam) {
+    size_t usado = 0;
+    buf[0] = '\0';
+    for (int k = 0; k < esp->total && usado < tam; ++k) {
+        int n = snprintf(buf + usado, tam - usado, "%s%s %s", k ? ", " : "",
+                         NOMES_CRITERIO[esp->criterio[k]], esp->decrescente[k] ? "desc" : "asc");
+        if (n < 0) break;
+        usado += (size_t)n;
+    }
+}
+
+/*
+ * Garante a visão composta de esp (ordenando só se necessário), exibe as métricas
+ * quando ela é ordenada e retorna 0 em sucesso.
+ */
+int executarOrdenacaoComposta(Inventario *inv, const EspecificacaoOrdenacao *esp) {
+    unsigned long long comps = 0;
+    double tsec = 0.0;
+    char descricao[96];
+    descreverEspecificacao(esp, descricao, sizeof(descricao));
+    contadoresHwComecar(&contadoresSessao);
+    int r = inventarioGarantirComposta(inv, esp, &comps, &tsec);
+    contadoresHwParar(&contadoresSessao);
+    if (r < 0) {
+        printf("Memória insuficiente (ou mais de %u componentes) para a visão composta.\n", UINT32_MAX);
+        return -1;
+    }
+    if (r == 1) {
+        printf("\nMerge Sort composto (%s) concluído: comparações = %llu, tempo = %.9f s\n", descricao, comps, tsec);
+        mostrarContadoresHw(&contadoresSessao);
+    } else {
+        printf("\nVisão composta (%s) já ordenada: nenhuma comparação necessária.\n", descricao);
+    }
+    return 0;
+}
+
+/*
+ * Garante a visão do critério (ordenando só se inválida), exibe as métricas
+ * da ordenação quando ela ocorre e retorna 0 em sucesso.
+ */
+int prepararVisao(Inventario *inv, CriterioOrdenacao criterio) {
+    unsigned long long comps = 0;
+    double tsec = 0.0;
+    contadoresHwComecar(&contadoresSessao);
+    int r = inventarioGarantirVisao(inv, criterio, &comps, &tsec);
+    contadoresHwParar(&contadoresSessao);
+    if (r < 0) {
+        printf("Memória insuficiente (ou mais de %u componentes) para a visão de índices.\n", UINT32_MAX);
+        return -1;
+    }
+    if (r == 1) {
+        printf("\n%s Sort por %s (visão de índices) concluído: comparações = %llu, tempo = %.9f s\n",
+               criterio == CRITERIO_NOME ? "Merge" : "Counting", NOMES_CRITERIO[criterio], comps, tsec);
+        mostrarContadoresHw(&contadoresSessao);
+    } else {
+        printf("\nVisão por %s já ordenada: nenhuma comparação necessária.\n", NOMES_CRITERIO[criterio]);
+    }
+    return 0;
+}
+
+/*
+ * Ordena os registros por tipo (1 = Insertion Sort, 2 = Bucket Sort paralelo)
+ * e exibe as métricas. Retorna 0 em sucesso.
+ */
+int ordenarPorTipo(VetorComponentes *v, int algoritmo) {
+    unsigned long long comps = 0;
+    double tsec = 0.0;
+    if (algoritmo == 2) return executarBucketSortParalelo(v, CRITERIO_TIPO);
+    if (algoritmo != 1) {
+        printf("Algoritmo inválido.\n");
+        return -1;
+    }
+    contadoresHwComecar(&contadoresSessao);
+    insertionSortTipo(v, &comps, &tsec);
+    contadoresHwParar(&contadoresSessao);
+    printf("\nInsertion Sort por TIPO concluído: comparações = %llu, tempo = %.9f s\n", comps, tsec);
+    mostrarContadoresHw(&contadoresSessao);
+    return 0;
+}
+
+/*
+ * Ordena por prioridade com o algoritmo escolhido (1 = Selection Sort, 2 = Counting Sort,
+ * 3 = Bucket Sort paralelo) e exibe as métricas. Retorna 0 em sucesso.
+ */
+int ordenarPorPrioridade(VetorComponentes *v, int algoritmo) {
+    unsigned long long comps = 0;
+    double tsec = 0.0;
+    if (algoritmo == 1) {
+        contadoresHwComecar(&contadoresSessao);
+        selectionSortPrioridade(v, &comps, &tsec);
+        contadoresHwParar(&contadoresSessao);
+        printf("\nSelection Sort por PRIORIDADE concluído: comparações = %llu, tempo = %.9f s\n", comps, tsec);
+    } else if (algoritmo == 2) {
+        contadoresHwComecar(&contadoresSessao);
+        int r = countingSortPrioridade(v, &comps, &tsec);
+        contadoresHwParar(&contadoresSessao);
+        if (r != 0) {
+            printf("Memória insuficiente para o Counting Sort.\n");
+            return -1;
+        }
+        printf("\nCounting Sort por PRIORIDADE concluído: comparações = %llu, tempo = %.9f s\n", comps, tsec);
+    } else if (algoritmo == 3) {
+        return executarBucketSortParalelo(v, CRITERIO_PRIORIDADE);
+    } else {
+        printf("Algoritmo inválido.\n");
+        return -1;
+    }
+    mostrarContadoresHw(&contadoresSessao);
+    return 0;
+}
+
+/* busca binária na visão por nome (ordenando-a antes, se necessário) e exibe o resultado */
+int executarBuscaBinaria(Inventario *inv, const char *chave) {
+    const VetorComponentes *componentes = &inv->itens;
+    /* a visão por nome é persistente: só é ordenada se ainda não for válida */
+    if (!inv->visaoValida[CRITERIO_NOME] && prepararVisao(inv, CRITERIO_NOME) != 0) return -1;
+
+    const VisaoIndices *visaoNome = &inv->visoes[CRITERIO_NOME];
+    FonteComponentes f = inventarioFonte(inv);
+    unsigned long long compsBusca = 0;
+    contadoresHwComecar(&contadoresSessao);
+    double t0 = relogioSeg();
+    long pos = buscaBinariaPorNomeVisao(&f, visaoNome, chave, &compsBusca);
+    double t1 = relogioSeg();
+    contadoresHwParar(&contadoresSessao);
+    double tempoBusca = t1 - t0;
+
+    if (pos >= 0) {
+        uint32_t id = visaoNome->indices[pos];
+        const Componente *c = &componentes->dados[id];
+        printf("\nComponente encontrado na posição %ld da visão por NOME (ID %lu):\n", pos, (unsigned long)id + 1);
+        printf("Nome: %s | Tipo: %s | Prioridade: %d\n", c->nome, tipoTexto(c->tipoId), c->prioridade);
+    } else {
+        printf("\nComponente '%s' não encontrado.\n", chave);
+    }
+    printf("Busca binária: comparações = %llu, tempo = %.9f s\n", compsBusca, tempoBusca);
+    mostrarContadoresHw(&contadoresSessao);
+    return 0;
+}
+
+/* busca pelo índice hash (reconstruindo-o se necessário) e exibe o resultado */
+int executarBuscaHash(Inventario *inv, const char *chave) {
+    const VetorComponentes *componentes = &inv->itens;
+    if (inventarioGarantirHash(inv) != 0) {
+        printf("Memória insuficiente para o índice hash.\n");
+        return -1;
+    }
+
+    unsigned long long sondagens = 0;
+    FonteComponentes f = inventarioFonte(inv);
+    double t0 = relogioSeg();
+    long id = hashBuscarPorNome(&inv->hashNome, &f, chave, &sondagens);
+    double t1 = relogioSeg();
+    double tempoBusca = t1 - t0;
+
+    if (id >= 0) {
+        const Componente *c = &componentes->dados[id];
+        printf("\nComponente encontrado (ID %ld):\n", id + 1);
+        printf("Nome: %s | Tipo: %s | Prioridade: %d\n", c->nome, tipoTexto(c->tipoId), c->prioridade);
+    } else {
+        printf("\nComponente '%s' não encontrado.\n", chave);
+    }
+    printf("Busca hash: sondagens = %llu, tempo = %.9f s\n", sondagens, tempoBusca);
+    return 0;
+}
+
+/*
+ * Confere uma lista de nomes (arquivo com um nome por linha) contra o inventário
+ * com a busca em lote na visão por nome e exibe o resumo e os primeiros nomes
+ * ausentes. Retorna 0 em sucesso.
+ */
+int executarBuscaLote(Inventario *inv, const char *caminho) {
+    FILE *arq = fopen(caminho, "r");
+    if (!arq) {
+        printf("Não foi possível ler '%s'.\n", caminho);
+        return -1;
+    }
+    size_t m = 0, capacidade = 0;
+    char **nomes = NULL;
+    char linha[1024];
+    int falhou = 0;
+    while (!falhou && fgets(linha, sizeof(linha), arq) != NULL) {
+        /* como na carga CSV/TSV: aceita CRLF, espaços e aspas em volta do nome */
+        char *nome = limparCampo(linha, linha + strcspn(linha, "\r\n"));
+        if (nome[0] == '\0') continue;
+        if (m == capacidade) {
+            size_t nova = capacidade ? capacidade * 2 : CAPACIDADE_INICIAL;
+            char **novos = realloc(nomes, nova * sizeof(char *));
+            if (!novos) {
+                falhou = 1;
+                break;
+            }
+            nomes = novos;
+            capacidade = nova;
+        }
+        nomes[m] = malloc(strlen(nome) + 1);
+        if (!nomes[m]) falhou = 1;
+        else strcpy(nomes[m++], nome);
+    }
+    fclose(arq);
+
+    long *posicoes = falhou ? NULL : malloc((m ? m : 1) * sizeof(long));
+    int r = -1;
+    if (posicoes && (inv->visaoValida[CRITERIO_NOME] || prepararVisao(inv, CRITERIO_NOME) == 0)) {
+        const VisaoIndices *visaoNome = &inv->visoes[CRITERIO_NOME];
+        FonteComponentes f = inventarioFonte(inv);
+        unsigned long long compsOrdenacao = 0, compsVarredura = 0;
+        contadoresHwComecar(&contadoresSessao);
+        double t0 = relogioSeg();
+        r = buscaLotePorNomeVisao(&f, visaoNome, (const char *const *)nomes, m, posicoes, &compsOrdenacao, &compsVarredura);
+        double t1 = relogioSeg();
+        contadoresHwParar(&contadoresSessao);
+        if (r == 0) {
+            size_t encontrados = 0;
+            for (size_t i = 0; i < m; ++i) encontrados += (posicoes[i] >= 0);
+            double tsec = t1 - t0;
+            printf("\nBusca em lote: %zu consultas, %zu encontradas, %zu ausentes\n", m, encontrados, m - encontrados);
+            printf("Comparações: ordenação das consultas = %llu, varredura da visão = %llu (%.2f por consulta)\n",
+                   compsOrdenacao, compsVarredura, m ? (double)compsVarredura / (double)m : 0.0);
+            printf("Tempo = %.9f s (%.0f consultas/s)\n", tsec, tsec > 0.0 ? (double)m / tsec : 0.0);
+            mostrarContadoresHw(&contadoresSessao);
+            size_t exibidos = 0;
+            for (size_t i = 0; i < m && exibidos < 10; ++i) {
+                if (posicoes[i] >= 0) continue;
+                if (exibidos++ == 0) printf("Ausentes:\n");
+                printf("  %s\n", nomes[i]);
+            }
+            if (exibidos < m - encontrados) printf("  ... (%zu de %zu exibidos)\n", exibidos, m - encontrados);
+        }
+    }
+    if (r != 0 && (falhou || !posicoes)) printf("Memória insuficiente para a busca em lote.\n");
+
+    for (size_t i = 0; i < m; ++i) free(nomes[i]);
+    free(nomes);
+    free(posicoes);
+    return r;
+}
+
+/* lista até 'limite' componentes cujo nome começa com 'prefixo' (autocompletar); retorna 0 em sucesso */
+int executarBuscaPrefixo(Inventario *inv, const char *prefixo, size_t limite) {
+    if (!inv->visaoValida[CRITERIO_NOME] && prepararVisao(inv, CRITERIO_NOME) != 0) return -1;
+    const VisaoIndices *visaoNome = &inv->visoes[CRITERIO_NOME];
+    FonteComponentes f = inventarioFonte(inv);
+    size_t inicio = 0, fim = 0;
+    unsigned long long comps = 0;
+    contadoresHwComecar(&contadoresSessao);
+    double t0 = relogioSeg();
+    buscaPrefixoVisao(&f, visaoNome, prefixo, &inicio, &fim, &comps);
+    double t1 = relogioSeg();
+    contadoresHwParar(&contadoresSessao);
+
+    size_t total = fim - inicio;
+    printf("\nPrefixo '%s': %zu componentes (posições %zu a %zu da visão por NOME)\n", prefixo, total, inicio,
+           total ? fim - 1 : inicio);
+    printf("Busca por prefixo: comparações = %llu, tempo = %.9f s\n", comps, t1 - t0);
+    mostrarContadoresHw(&contadoresSessao);
+    if (total == 0) return 0;
+    size_t n = total < limite ? total : limite;
+    VisaoIndices resultado = { visaoNome->indices + inicio, n, 1, 0 };
+    mostrarComponentesVisao(&f, &resultado);
+    if (n < total) printf("... (%zu de %zu exibidos)\n", n, total);
+    return 0;
+}
+
+/* carrega um CSV/TSV (acrescentando ou substituindo) e exibe o resumo */
+int executarCargaArquivo(Inventario *inv, const char *caminho, int substituir) {
+    if (substituir) inventarioLimpar(inv);
+    size_t rejeitadas = 0;
+    double t0 = relogioSeg();
+    long carregados = carregarArquivoDelimitado(inv, caminho, &rejeitadas);
+    double t1 = relogioSeg();
+    if (carregados < 0) {
+        printf("Não foi possível ler '%s'.\n", caminho);
+        return -1;
+    }
+    vetorAjustarCapacidade(&inv->itens); /* a reserva contou linhas; cabeçalho e rejeitadas sobram */
+    printf("\nCarga concluída: %ld componentes carregados, %zu linhas rejeitadas, total = %zu, tempo = %.6f s\n",
+           carregados, rejeitadas, inv->itens.total, t1 - t0);
+    return 0;
+}
+
+/*
+ * Acrescenta um componente "nome,tipo,prioridade" e exibe onde ele entrou na visão
+ * por nome (mantida em ordem se já era válida). Retorna 0 em sucesso.
+ */
+int executarInsercao(Inventario *inv, char *texto) {
+    char *fim = texto + strlen(texto);
+    char *sep1 = strchr(texto, ',');
+    char *sep2 = sep1 ? strchr(sep1 + 1, ',') : NULL;
+    if (!sep2) {
+        printf("inserir: use 'inserir <nome>,<tipo>,<prioridade>'.\n");
+        return -1;
+    }
+    char *nome = limparCampo(texto, sep1);
+    char *tipo = limparCampo(sep1 + 1, sep2);
+    char *campoPrio = limparCampo(sep2 + 1, fim);
+    char *resto;
+    long prio = strtol(campoPrio, &resto, 10);
+    if (resto == campoPrio || *resto != '\0' || prio < PRIORIDADE_MIN || prio > PRIORIDADE_MAX) {
+        printf("inserir: prioridade deve ser de %d a %d.\n", PRIORIDADE_MIN, PRIORIDADE_MAX);
+        return -1;
+    }
+
+    VetorComponentes *v = &inv->itens;
+    Componente *c = vetorAdicionar(v);
+    if (!c) {
+        printf("Memória insuficiente para inserir o componente.\n");
+        return -1;
+    }
+    copiarCampo(c->nome, MAX_NOME, nome, NOME_PADRAO);
+    c->prioridade = (int)prio;
+    if (componenteDefinirTipo(c, tipo) != 0) {
+        v->total--;
+        printf("Memória insuficiente para um novo tipo.\n");
+        return -1;
+    }
+    double t0 = relogioSeg();
+    long pos = inventarioAposInsercao(inv, v->total - 1);
+    double t1 = relogioSeg();
+
+    printf("Componente '%s' inserido (ID %zu), tempo = %.9f s\n", c->nome, v->total, t1 - t0);
+    if (pos >= 0) {
+        printf("Visão por NOME mantida em ordem: posição %ld de %zu.\n", pos, inv->visoes[CRITERIO_NOME].total);
+    } else {
+        printf("Visão por NOME inválida: será ordenada na próxima busca.\n");
+    }
+    return 0;
+}
+
+/* salva (salvar = 1) ou abre (salvar = 0) o inventário binário e exibe o resumo */
+int executarArquivoBinario(Inventario *inv, const char *caminho, int salvar) {
+    double t0 = relogioSeg();
+    int r = salvar ? salvarInventarioBinario(inv, caminho) : abrirInventarioBinario(inv, caminho);
+    double t1 = relogioSeg();
+    double tsec = t1 - t0;
+    if (r == -2) {
+        printf("'%s' não é um inventário binário compatível (versão %d).\n", caminho, FORMATO_VERSAO);
+    } else if (r != 0) {
+        printf("Não foi possível %s '%s'.\n", salvar ? "gravar" : "ler", caminho);
+    } else if (salvar) {
+        printf("\nInventário salvo: %zu componentes, tempo = %.6f s\n", inv->itens.total, tsec);
+    } else {
+        printf("\nInventário aberto: %zu componentes, visões prontas: %s%s%s, tempo = %.6f s\n",
+               inv->itens.total,
+               inv->visaoValida[CRITERIO_NOME] ? "NOME " : "",
+               inv->visaoValida[CRITERIO_TIPO] ? "TIPO " : "",
+               inv->visaoValida[CRITERIO_PRIORIDADE] ? "PRIORIDADE" : "", tsec);
+    }
+    return r == 0 ? 0 : -1;
+}
+
+/*
+ * Mede a ordenação 'nomeAlgoritmo' do critério com repetições sobre cópias do
+ * inventário (que não é alterado) e exibe as estatísticas. Retorna 0 em sucesso.
+ */
+int executarMedicaoOrdenacao(Inventario *inv, CriterioOrdenacao criterio, const char *nomeAlgoritmo, size_t repeticoes) {
+    const AlgoritmoOrdenacao *alg = algoritmoPorNome(nomeAlgoritmo, criterio);
+    if (!alg) {
+        printf("Algoritmo '%s' não se aplica ao critério %s.\n", nomeAlgoritmo, NOMES_CRITERIO[criterio]);
+        return -1;
+    }
+    EstatisticasTempo est;
+    unsigned long long comps = 0, movs = 0;
+    if (medirOrdenacao(alg, &inv->itens, repeticoes, &est, &comps, &movs) != 0) {
+        printf("Memória insuficiente para a medição.\n");
+        return -1;
+    }
+    printf("\n%s por %s: comparações = %llu, movimentos = %llu\n", alg->nome, NOMES_CRITERIO[criterio], comps, movs);
+    mostrarEstatisticas(&est);
+    return 0;
+}
+
+/* mede a busca binária na visão por nome com repetições e exibe as estatísticas */
+int executarMedicaoBusca(Inventario *inv, const char *chave, size_t repeticoes) {
+    if (!inv->visaoValida[CRITERIO_NOME] && prepararVisao(inv, CRITERIO_NOME) != 0) return -1;
+    EstatisticasTempo est;
+    unsigned long long comps = 0;
+    long pos = medirBuscaBinaria(inv, chave, repeticoes, &est, &comps);
+    printf("\nBusca binária por '%s': %s, comparações = %llu\n", chave, pos >= 0 ? "encontrado" : "não encontrado", comps);
+    if (est.repeticoes > 0) mostrarEstatisticas(&est);
+    return 0;
+}
+
+/* define as threads das ordenações paralelas (0 = automático) e exibe o valor efetivo */
+void definirThreadsOrdenacao(int threads) {
+    threadsOrdenacao = (threads < 0) ? 0 : (threads > MAX_THREADS ? MAX_THREADS : threads);
+    printf("Ordenações paralelas: %d threads%s; inventários pequenos usam menos (mín. %d componentes por thread).\n",
+           threadsParaOrdenar(SIZE_MAX), threadsOrdenacao == 0 ? " (automático)" : "", LIMIAR_PARALELO);
+}
+
+/* liga ou desliga o armazenamento em colunas e exibe o resultado; retorna 0 em sucesso */
+int executarAlternarColunas(Inventario *inv, int ligar) {
+    double t0 = relogioSeg();
+    int r = inventarioDefinirColunas(inv, ligar);
+    double t1 = relogioSeg();
+    if (r != 0) {
+        printf("Memória insuficiente para as colunas; armazenamento continua em REGISTROS.\n");
+        return -1;
+    }
+    if (ligar) {
+        size_t bytesLinha = MAX_NOME + sizeof(uint32_t) + sizeof(uint8_t) + sizeof(uint64_t) + TAM_CHAVE;
+        printf("Armazenamento: COLUNAS (espelho dos registros em vetores separados; %zu linhas, "
+               "%.1f MB a mais, tempo = %.6f s)\n",
+               inv->colunas.total, (double)(inv->colunas.capacidade * bytesLinha) / (1024.0 * 1024.0), t1 - t0);
+    } else {
+        printf("Armazenamento: REGISTROS (visões, buscas e exibição leem os componentes inteiros)\n");
+    }
+    return 0;
+}
+
+/*
+ * Exibe os k componentes de maior prioridade. Se a visão por prioridade já é válida,
+ * basta ler seus k primeiros índices; senão seleciona com o heap, sem ordenar tudo.
+ * Retorna 0 em sucesso.
+ */
+int executarTopK(Inventario *inv, size_t k) {
+    if (k > inv->itens.total) k = inv->itens.total;
+    uint32_t *ids = malloc((k ? k : 1) * sizeof(uint32_t));
+    if (!ids || inventarioGarantirColunas(inv) != 0) {
+        free(ids);
+        printf("Memória insuficiente para a seleção dos %zu mais prioritários.\n", k);
+        return -1;
+    }
+    FonteComponentes f = inventarioFonte(inv);
+    if (inv->visaoValida[CRITERIO_PRIORIDADE]) {
+        memcpy(ids, inv->visoes[CRITERIO_PRIORIDADE].indices, k * sizeof(uint32_t));
+        printf("\nTop-%zu lido da visão por PRIORIDADE já ordenada: nenhuma comparação necessária.\n", k);
+    } else {
+        unsigned long long comps = 0;
+        double tsec = 0.0;
+        contadoresHwComecar(&contadoresSessao);
+        k = selecionarTopK(&f, inv->itens.total, k, ids, &comps, &tsec);
+        contadoresHwParar(&contadoresSessao);
+        printf("\nTop-%zu por PRIORIDADE (heap, O(n log k)) concluído: comparações = %llu, tempo = %.9f s\n",
+               k, comps, tsec);
+        mostrarContadoresHw(&contadoresSessao);
+    }
+    VisaoIndices selecao = { ids, k, 0, k };
+    mostrarComponentesVisao(&f, &selecao);
+    free(ids);
+    return 0;
+}
+
+/* inicia (ou reinicia) a fila de montagem com todos os componentes e exibe o resumo */
+int executarIniciarMontagem(Inventario *inv) {
+    double t0 = relogioSeg();
+    int r = inventarioIniciarMontagem(inv);
+    double t1 = relogioSeg();
+    if (r != 0) {
+        printf("Memória insuficiente (ou mais de %u componentes) para a fila de montagem.\n", UINT32_MAX);
+        return -1;
+    }
+    printf("\nFila de montagem: %zu componentes em %d baldes de prioridade, tempo = %.6f s\n",
+           inv->montagem.total, PRIORIDADE_MAX - PRIORIDADE_MIN + 1, t1 - t0);
+    return 0;
+}
+
+/* retira e exibe até 'quantidade' componentes, do mais prioritário ao menos; retorna 0 em sucesso */
+int executarRetirarMontagem(Inventario *inv, size_t quantidade) {
+    if (!inv->montagemAtiva) {
+        printf("Fila de montagem inativa: inicie a montagem primeiro.\n");
+        return -1;
+    }
+    if (quantidade > inv->montagem.total) quantidade = inv->montagem.total;
+    uint32_t *ids = malloc((quantidade ? quantidade : 1) * sizeof(uint32_t));
+    int *prioridades = malloc((quantidade ? quantidade : 1) * sizeof(int));
+    if (!ids || !prioridades) {
+        free(ids);
+        free(prioridades);
+        printf("Memória insuficiente.\n");
+        return -1;
+    }
+    double t0 = relogioSeg();
+    for (size_t i = 0; i < quantidade; ++i) ids[i] = filaRetirarMaior(&inv->montagem, &prioridades[i]);
+    double t1 = relogioSeg();
+
+    printf("\nRetirados %zu componentes da fila de montagem: tempo = %.9f s, restam %zu\n",
+           quantidade, t1 - t0, inv->montagem.total);
+    if (quantidade > 0) {
+        /* exibe a prioridade que tinham na fila (pode ter sido ajustada), a que define a ordem */
+        printf("PRIORIDADE abaixo = prioridade na fila de montagem\n");
+        mostrarCabecalho(quantidade);
+        for (size_t i = 0; i < quantidade; ++i) {
+            const Componente *c = &inv->itens.dados[ids[i]];
+            mostrarCampos((size_t)ids[i] + 1, c->nome, c->tipoId, prioridades[i]);
+        }
+    }
+    free(ids);
+    free(prioridades);
+    return 0;
+}
+
+/*
+ * Altera a prioridade de um componente na fila de montagem (0 = tira da fila),
+ * localizando-o pelo nome no índice hash. O registro no inventário não muda.
+ */
+int executarAjusteMontagem(Inventario *inv, const char *nome, int prioridade) {
+    if (!inv->montagemAtiva) {
+        printf("Fila de montagem inativa: inicie a montagem primeiro.\n");
+        return -1;
+    }
+    if (inventarioGarantirHash(inv) != 0) {
+        printf("Memória insuficiente para o índice hash.\n");
+        return -1;
+    }
+    unsigned long long sondagens = 0;
+    FonteComponentes f = inventarioFonte(inv);
+    long id = hashBuscarPorNome(&inv->hashNome, &f, nome, &sondagens);
+    if (id < 0) {
+        printf("Componente '%s' não encontrado.\n", nome);
+        return -1;
+    }
+    int r = (prioridade == 0) ? filaRemover(&inv->montagem, (uint32_t)id)
+                              : filaAlterarPrioridade(&inv->montagem, (uint32_t)id, prioridade);
+    if (r != 0) {
+        printf("Componente '%s' (ID %ld) não está na fila de montagem.\n", nome, id + 1);
+        return -1;
+    }
+    if (prioridade == 0) printf("Componente '%s' (ID %ld) removido da fila; restam %zu.\n", nome, id + 1, inv->montagem.total);
+    else printf("Componente '%s' (ID %ld) agora com prioridade %d na fila.\n", nome, id + 1, prioridade);
+    return 0;
+}
+
+/* laço interativo da montagem: retira componentes em ordem de prioridade e ajusta a fila */
+static void menuMontagem(Inventario *inv) {
+    if (!inv->montagemAtiva && executarIniciarMontagem(inv) != 0) return;
+    char texto[MAX_NOME];
+    while (1) {
+        printf("\n--- Montagem da torre (na fila: %zu) ---\n", inv->montagem.total);
+        printf("1 - Retirar o próximo componente  2 - Retirar vários  3 - Remover da fila por NOME\n");
+        printf("4 - Alterar prioridade na fila por NOME  5 - Reiniciar a fila  0 - Voltar\n");
+        printf("Escolha [1]: ");
+        int escolha = lerInteiro(1);
+        if (escolha == 0) {
+            break;
+        } else if (escolha == 1 || escolha == 2) {
+            int quantidade = 1;
+            if (escolha == 2) {
+                printf("Quantos [10]: ");
+                quantidade = lerInteiro(10);
+            }
+            if (quantidade > 0) executarRetirarMontagem(inv, (size_t)quantidade);
+        } else if (escolha == 3 || escolha == 4) {
+            printf("Nome do componente: ");
+            if (fgets(texto, sizeof(texto), stdin) == NULL) break;
+            trim_newline(texto);
+            int prioridade = 0;
+            if (escolha == 4) {
+                printf("Nova prioridade (%d-%d): ", PRIORIDADE_MIN, PRIORIDADE_MAX);
+                prioridade = lerInteiro(0);
+                if (prioridade < PRIORIDADE_MIN || prioridade > PRIORIDADE_MAX) {
+                    printf("Valor inválido.\n");
+                    continue;
+                }
+            }
+            executarAjusteMontagem(inv, texto, prioridade);
+        } else if (escolha == 5) {
+            executarIniciarMontagem(inv);
+        } else {
+            printf("Opção inválida.\n");
+        }
+    }
+}
 
 void menuPrincipal() {
-    Componente componentes[MAX_COMPONENTES];
-    int total = 0;
-    int ordenadoPorNome = 0; /* flag para saber se está ordenado por nome (para habilitar busca binária) */
+    Inventario inv;
+    inventarioIniciar(&inv);
+    VetorComponentes *componentes = &inv.itens;
+    int modoIndices = 1; /* 1: opções 2-4 ordenam visões de índices e não movem os registros */
     char opcaoBuf[32];
 
     while (1) {
         printf("\n========== MONTAGEM TORRE DE FUGA ==========\n");
         printf("1 - Cadastrar componentes\n");
-        printf("2 - Ordenar por NOME (Bubble Sort) e medir (recomendado para busca)\n");
-        printf("3 - Ordenar por TIPO (Insertion Sort) e medir\n");
-        printf("4 - Ordenar por PRIORIDADE (Selection Sort) e medir\n");
-        printf("5 - Buscar componente-chave por NOME (Busca Binária) [requer ordenação por NOME]\n");
+        if (modoIndices) {
+            /* as visões usam um algoritmo fixo por critério; a escolha existe só no modo REGISTROS (opção 7) */
+            printf("2 - Ordenar por NOME (visão de índices, Merge Sort) e medir\n");
+            printf("3 - Ordenar por TIPO (visão de índices, Counting Sort) e medir\n");
+            printf("4 - Ordenar por PRIORIDADE (visão de índices, Counting Sort) e medir\n");
+        } else {
+            printf("2 - Ordenar por NOME (Bubble Sort, Merge Sort ou Merge Sort paralelo) e medir\n");
+            printf("3 - Ordenar por TIPO (Insertion Sort ou Bucket Sort paralelo) e medir\n");
+            printf("4 - Ordenar por PRIORIDADE (Selection Sort, Counting Sort ou Bucket Sort paralelo) e medir\n");
+        }
+        printf("5 - Buscar componente-chave por NOME (Busca Binária na visão por NOME)\n");
         printf("6 - Mostrar componentes atuais\n");
+        printf("7 - Alternar modo de ordenação (atual: %s)\n", modoIndices ? "ÍNDICES" : "REGISTROS");
+        printf("8 - Buscar componente por NOME (índice hash, O(1) esperado)\n");
+        printf("9 - Carregar componentes de arquivo CSV/TSV (nome, tipo, prioridade)\n");
+        printf("10 - Salvar inventário em arquivo binário (com visões ordenadas)\n");
+        printf("11 - Abrir inventário de arquivo binário (mmap)\n");
+        printf("12 - Medir ordenação ou busca com repetições (mín/mediana/p99/média)\n");
+        printf("13 - %s contadores de hardware (perf)\n", contadoresSessao.ativo ? "Desligar" : "Ligar");
+        printf("14 - Alternar armazenamento das visões (atual: %s)\n", inv.modoColunas ? "COLUNAS" : "REGISTROS");
+        printf("15 - Definir threads das ordenações paralelas (atual: %d)\n", threadsParaOrdenar(SIZE_MAX));
+        printf("16 - Ordenar por várias chaves (ex.: tipo prioridade:desc nome) e exibir\n");
+        printf("17 - Listar os K componentes de maior prioridade (sem ordenar todos)\n");
+        printf("18 - Montagem da torre: retirar componentes em ordem de prioridade (fila por baldes)\n");
+        printf("19 - Conferir lista de nomes de um arquivo (busca em lote na visão por NOME)\n");
+        printf("20 - Buscar componentes por início do NOME (autocompletar)\n");
         printf("0 - Sair\n");
         printf("Escolha: ");
         if (fgets(opcaoBuf, sizeof(opcaoBuf), stdin) == NULL) break;
@@ -252,99 +3884,706 @@ void menuPrincipal() {
             printf("Entrada inválida.\n");
             continue;
         }
+        conferirInventario(&inv); /* após abrir um arquivo binário (opção 11) */
 
         if (opcao == 0) {
             printf("Encerrando módulo de montagem. Boa sorte na fuga!\n");
             break;
         } else if (opcao == 1) {
-            cadastrarComponentes(componentes, &total);
-            ordenadoPorNome = 0;
-            mostrarComponentes(componentes, total);
+            int substituir = 1;
+            if (componentes->total > 0) {
+                printf("Substituir os componentes atuais? (s/n): ");
+                char ans[8];
+                if (fgets(ans, sizeof(ans), stdin) == NULL) continue;
+                substituir = (ans[0] == 's' || ans[0] == 'S');
+            }
+            cadastrarComponentes(&inv, substituir);
+            mostrarComponentes(componentes);
         } else if (opcao == 2) {
-            if (total == 0) {
+            if (componentes->total == 0) {
                 printf("Nenhum componente cadastrado.\n");
                 continue;
             }
-            unsigned long long comps = 0;
-            double tsec = 0.0;
-            bubbleSortNome(componentes, total, &comps, &tsec);
-            ordenadoPorNome = 1;
-            printf("\nBubble Sort por NOME concluído: comparações = %llu, tempo = %.6f s\n", comps, tsec);
-            mostrarComponentes(componentes, total);
+            if (modoIndices) {
+                if (prepararVisao(&inv, CRITERIO_NOME) == 0) {
+                    FonteComponentes f = inventarioFonte(&inv);
+                    mostrarComponentesVisao(&f, &inv.visoes[CRITERIO_NOME]);
+                }
+                continue;
+            }
+            printf("Algoritmo: 1 - Bubble Sort (O(n^2))  2 - Merge Sort (O(n log n))  3 - Merge Sort paralelo [2]: ");
+            int algoritmo = lerInteiro(2);
+            if (ordenarPorNome(componentes, algoritmo) != 0) continue;
+            if (inventarioRegistrosOrdenadosPorNome(&inv) != 0) inventarioRegistrosMovidos(&inv);
+            mostrarComponentes(componentes);
         } else if (opcao == 3) {
-            if (total == 0) {
+            if (componentes->total == 0) {
                 printf("Nenhum componente cadastrado.\n");
                 continue;
             }
-            unsigned long long comps = 0;
-            double tsec = 0.0;
-            insertionSortTipo(componentes, total, &comps, &tsec);
-            ordenadoPorNome = 0;
-            printf("\nInsertion Sort por TIPO concluído: comparações = %llu, tempo = %.6f s\n", comps, tsec);
-            mostrarComponentes(componentes, total);
+            if (modoIndices) {
+                if (prepararVisao(&inv, CRITERIO_TIPO) == 0) {
+                    FonteComponentes f = inventarioFonte(&inv);
+                    mostrarComponentesVisao(&f, &inv.visoes[CRITERIO_TIPO]);
+                }
+                continue;
+            }
+            printf("Algoritmo: 1 - Insertion Sort (O(n^2))  2 - Bucket Sort paralelo (O(n + k)) [2]: ");
+            int algoritmo = lerInteiro(2);
+            if (ordenarPorTipo(componentes, algoritmo) != 0) continue;
+            inventarioRegistrosMovidos(&inv);
+            mostrarComponentes(componentes);
         } else if (opcao == 4) {
-            if (total == 0) {
+            if (componentes->total == 0) {
                 printf("Nenhum componente cadastrado.\n");
                 continue;
             }
-            unsigned long long comps = 0;
-            double tsec = 0.0;
-            selectionSortPrioridade(componentes, total, &comps, &tsec);
-            ordenadoPorNome = 0;
-            printf("\nSelection Sort por PRIORIDADE concluído: comparações = %llu, tempo = %.6f s\n", comps, tsec);
-            mostrarComponentes(componentes, total);
+            if (modoIndices) {
+                if (prepararVisao(&inv, CRITERIO_PRIORIDADE) == 0) {
+                    FonteComponentes f = inventarioFonte(&inv);
+                    mostrarComponentesVisao(&f, &inv.visoes[CRITERIO_PRIORIDADE]);
+                }
+                continue;
+            }
+            printf("Algoritmo: 1 - Selection Sort (O(n^2))  2 - Counting Sort (O(n + k), estável)  3 - Bucket Sort paralelo [2]: ");
+            int algoritmo = lerInteiro(2);
+            if (ordenarPorPrioridade(componentes, algoritmo) != 0) continue;
+            inventarioRegistrosMovidos(&inv);
+            mostrarComponentes(componentes);
         } else if (opcao == 5) {
-            if (total == 0) {
+            if (componentes->total == 0) {
                 printf("Nenhum componente cadastrado.\n");
                 continue;
             }
-            if (!ordenadoPorNome) {
-                printf("Atenção: busca binária requer que os componentes estejam ordenados por NOME.\n");
-                printf("Deseja executar Bubble Sort por NOME agora? (s/n): ");
-                char ans[8];
-                if (fgets(ans, sizeof(ans), stdin) == NULL) continue;
-                if (ans[0] == 's' || ans[0] == 'S') {
-                    unsigned long long comps = 0;
-                    double tsec = 0.0;
-                    bubbleSortNome(componentes, total, &comps, &tsec);
-                    ordenadoPorNome = 1;
-                    printf("\nBubble Sort por NOME concluído: comparações = %llu, tempo = %.6f s\n", comps, tsec);
-                } else {
-                    printf("Busca cancelada. Ordene por NOME antes de usar busca binária.\n");
-                    continue;
-                }
-            }
-
             char chave[MAX_NOME];
             printf("Digite o nome do componente-chave a buscar: ");
             if (fgets(chave, sizeof(chave), stdin) == NULL) continue;
             trim_newline(chave);
+            executarBuscaBinaria(&inv, chave);
+        } else if (opcao == 6) {
+            mostrarComponentes(componentes);
+        } else if (opcao == 7) {
+            modoIndices = !modoIndices;
+            printf("Modo de ordenação: %s\n", modoIndices
+                   ? "ÍNDICES (registros permanecem no lugar; cada critério tem sua visão)"
+                   : "REGISTROS (ordenações movem os componentes e invalidam as visões)");
+        } else if (opcao == 8) {
+            if (componentes->total == 0) {
+                printf("Nenhum componente cadastrado.\n");
+                continue;
+            }
+            char chave[MAX_NOME];
+            printf("Digite o nome do componente a buscar: ");
+            if (fgets(chave, sizeof(chave), stdin) == NULL) continue;
+            trim_newline(chave);
+            executarBuscaHash(&inv, chave);
+        } else if (opcao == 9) {
+            char caminho[512];
+            printf("Caminho do arquivo: ");
+            if (fgets(caminho, sizeof(caminho), stdin) == NULL) continue;
+            trim_newline(caminho);
+            printf("Substituir os componentes atuais? (s/n): ");
+            char ans[8];
+            if (fgets(ans, sizeof(ans), stdin) == NULL) continue;
+            executarCargaArquivo(&inv, caminho, ans[0] == 's' || ans[0] == 'S');
+        } else if (opcao == 10 || opcao == 11) {
+            char caminho[512];
+            printf("Caminho do arquivo binário: ");
+            if (fgets(caminho, sizeof(caminho), stdin) == NULL) continue;
+            trim_newline(caminho);
 
-            unsigned long long compsBusca = 0;
-            clock_t t0 = clock();
-            int idx = buscaBinariaPorNome(componentes, total, chave, &compsBusca);
-            clock_t t1 = clock();
-            double tempoBusca = (double)(t1 - t0) / CLOCKS_PER_SEC;
+            executarArquivoBinario(&inv, caminho, opcao == 10);
+        } else if (opcao == 12) {
+            if (componentes->total == 0) {
+                printf("Nenhum componente cadastrado.\n");
+                continue;
+            }
+            printf("Medir: 1 - NOME  2 - TIPO  3 - PRIORIDADE  4 - BUSCA BINÁRIA [1]: ");
+            int alvo = lerInteiro(1);
+            if (alvo < 1 || alvo > 4) {
+                printf("Opção inválida.\n");
+                continue;
+            }
+            printf("Repetições [%d]: ", REPETICOES_PADRAO);
+            int repeticoes = lerInteiro(REPETICOES_PADRAO);
+            if (repeticoes < 1) repeticoes = 1;
 
-            if (idx >= 0) {
-                printf("\nComponente encontrado na posição %d (ID %d):\n", idx, idx+1);
-                printf("Nome: %s | Tipo: %s | Prioridade: %d\n", componentes[idx].nome, componentes[idx].tipo, componentes[idx].prioridade);
-            } else {
-                printf("\nComponente '%s' não encontrado.\n", chave);
+            char texto[MAX_NOME];
+            if (alvo == 4) {
+                printf("Nome a buscar: ");
+                if (fgets(texto, sizeof(texto), stdin) == NULL) continue;
+                trim_newline(texto);
+                executarMedicaoBusca(&inv, texto, (size_t)repeticoes);
+                continue;
             }
-            printf("Busca binária: comparações = %llu, tempo = %.6f s\n", compsBusca, tempoBusca);
-        } else if (opcao == 6) {
-            mostrarComponentes(componentes, total);
+            printf("Algoritmo (bubble, merge, paralelo, insertion, selection, counting, buckets, visao, colunas) [visao]: ");
+            if (fgets(texto, sizeof(texto), stdin) == NULL) continue;
+            trim_newline(texto);
+            executarMedicaoOrdenacao(&inv, (CriterioOrdenacao)(alvo - 1), texto[0] ? texto : "visao", (size_t)repeticoes);
+        } else if (opcao == 13) {
+            alternarContadoresHw(!contadoresSessao.ativo);
+        } else if (opcao == 14) {
+            executarAlternarColunas(&inv, !inv.modoColunas);
+        } else if (opcao == 15) {
+            printf("Threads (0 = uma por processador, máx. %d) [0]: ", MAX_THREADS);
+            definirThreadsOrdenacao(lerInteiro(0));
+        } else if (opcao == 16) {
+            if (componentes->total == 0) {
+                printf("Nenhum componente cadastrado.\n");
+                continue;
+            }
+            char texto[128];
+            EspecificacaoOrdenacao esp;
+            printf("Chaves em ordem de precedência, cada uma criterio[:asc|:desc] [tipo prioridade nome]: ");
+            if (fgets(texto, sizeof(texto), stdin) == NULL) continue;
+            trim_newline(texto);
+            if (texto[0] == '\0') strcpy(texto, "tipo prioridade nome");
+            if (lerEspecificacaoOrdenacao(texto, &esp) != 0) continue;
+            if (executarOrdenacaoComposta(&inv, &esp) == 0) {
+                FonteComponentes f = inventarioFonte(&inv);
+                mostrarComponentesVisao(&f, &inv.visaoComposta);
+            }
+        } else if (opcao == 17) {
+            if (componentes->total == 0) {
+                printf("Nenhum componente cadastrado.\n");
+                continue;
+            }
+            printf("Quantos componentes (K) [10]: ");
+            int k = lerInteiro(10);
+            if (k < 1) {
+                printf("K deve ser >= 1.\n");
+                continue;
+            }
+            executarTopK(&inv, (size_t)k);
+        } else if (opcao == 18) {
+            if (componentes->total == 0) {
+                printf("Nenhum componente cadastrado.\n");
+                continue;
+            }
+            menuMontagem(&inv);
+        } else if (opcao == 19) {
+            if (componentes->total == 0) {
+                printf("Nenhum componente cadastrado.\n");
+                continue;
+            }
+            char caminho[512];
+            printf("Arquivo com um nome por linha: ");
+            if (fgets(caminho, sizeof(caminho), stdin) == NULL) continue;
+            trim_newline(caminho);
+            executarBuscaLote(&inv, caminho);
+        } else if (opcao == 20) {
+            if (componentes->total == 0) {
+                printf("Nenhum componente cadastrado.\n");
+                continue;
+            }
+            char prefixo[MAX_NOME];
+            printf("Início do nome: ");
+            if (fgets(prefixo, sizeof(prefixo), stdin) == NULL) continue;
+            trim_newline(prefixo);
+            printf("Máximo de resultados [%d]: ", LIMITE_PREFIXO_PADRAO);
+            int limite = lerInteiro(LIMITE_PREFIXO_PADRAO);
+            executarBuscaPrefixo(&inv, prefixo, limite > 0 ? (size_t)limite : LIMITE_PREFIXO_PADRAO);
         } else {
             printf("Opção inválida.\n");
         }
     }
+    contadoresHwDesligar(&contadoresSessao);
+    inventarioLiberar(&inv);
+}
+
+/* ---------------- modo em lote (sem prompts) ---------------- */
+
+/*
+ * Algoritmos aceitos por "ordenar <criterio> [algoritmo]". "visao" ordena a visão
+ * de índices do critério (padrão); os demais ordenam os registros, como no modo
+ * REGISTROS do menu, e o número é o mesmo usado nos prompts do menu.
+ */
+typedef struct {
+    const char *nome;
+    CriterioOrdenacao criterio;
+    int numero;
+} AlgoritmoLote;
+
+static const AlgoritmoLote ALGORITMOS_LOTE[] = {
+    { "bubble",    CRITERIO_NOME,       1 },
+    { "merge",     CRITERIO_NOME,       2 },
+    { "paralelo",  CRITERIO_NOME,       3 },
+    { "insertion", CRITERIO_TIPO,       1 },
+    { "buckets",   CRITERIO_TIPO,       2 },
+    { "selection", CRITERIO_PRIORIDADE, 1 },
+    { "counting",  CRITERIO_PRIORIDADE, 2 },
+    { "buckets",   CRITERIO_PRIORIDADE, 3 },
+};
+
+/* separa a primeira palavra de *resto (in-place) e avança *resto para o argumento seguinte */
+static char *proximaPalavra(char **resto) {
+    char *p = *resto;
+    while (isspace((unsigned char)*p)) p++;
+    if (*p == '\0') return NULL;
+    char *ini = p;
+    while (*p && !isspace((unsigned char)*p)) p++;
+    if (*p) *p++ = '\0';
+    while (isspace((unsigned char)*p)) p++;
+    *resto = p;
+    return ini;
+}
+
+/* remove espaços finais (o argumento de texto livre é o resto da linha) */
+static void aparar(char *s) {
+    size_t len = strlen(s);
+    while (len > 0 && isspace((unsigned char)s[len-1])) s[--len] = '\0';
+}
+
+static void mostrarAjudaLote(void) {
+    printf("Comandos:\n");
+    printf("  carregar <arquivo>            acrescenta componentes de um CSV/TSV\n");
+    printf("  inserir <nome>,<tipo>,<prio>  acrescenta um componente mantendo a visão por nome ordenada\n");
+    printf("  limpar                        remove todos os componentes\n");
+    printf("  abrir <arquivo>               abre inventário binário (mmap)\n");
+    printf("  salvar <arquivo>              grava inventário binário\n");
+    printf("  ordenar <nome|tipo|prioridade> [visao|bubble|merge|paralelo|insertion|selection|counting|buckets]\n");
+    printf("  ordenar composta <chave>[:asc|:desc] ...  várias chaves em uma ordenação (ex.: tipo prioridade:desc nome)\n");
+    printf("  buscar <nome>                 busca binária na visão por nome\n");
+    printf("  hash <nome>                   busca pelo índice hash\n");
+    printf("  conferir <arquivo>            busca em lote dos nomes do arquivo (um por linha)\n");
+    printf("  prefixo [limite] <inicio>     componentes cujo nome começa com <inicio> (autocompletar)\n");
+    printf("  mostrar [nome|tipo|prioridade|composta] [limite]\n");
+    printf("  topk <k>                      os k componentes de maior prioridade (heap, sem ordenar todos)\n");
+    printf("  montar iniciar|estado         fila de montagem com todos os componentes (baldes por prioridade)\n");
+    printf("  montar proximo [n]            retira os n próximos componentes da fila, do mais prioritário\n");
+    printf("  montar remover <nome>         tira o componente da fila\n");
+    printf("  montar prioridade <p> <nome>  muda a prioridade do componente na fila\n");
+    printf("  medir <nome|tipo|prioridade> [algoritmo] [repeticoes]\n");
+    printf("  medir busca [repeticoes] <nome>\n");
+    printf("  perf <on|off>                 contadores de hardware nas ordenações e buscas\n");
+    printf("  colunas <on|off>              visões, buscas e exibição sobre um espelho em colunas (SoA, 2x memória)\n");
+    printf("  threads <n|auto>              threads das ordenações paralelas (paralelo, buckets)\n");
+    printf("  sair\n");
+    printf("Linhas vazias e iniciadas por '#' são ignoradas.\n");
+}
+
+/*
+ * Executa um comando do modo em lote.
+ * Retorna 0 em sucesso, 1 para encerrar ("sair") e -1 em erro.
+ */
+int executarComando(Inventario *inv, char *linha) {
+    trim_newline(linha);
+    char *resto = linha;
+    char *cmd = proximaPalavra(&resto);
+    if (!cmd || cmd[0] == '#') return 0;
+    aparar(resto);
+    conferirInventario(inv); /* após "abrir" */
+
+    if (strcmp(cmd, "sair") == 0) return 1;
+    if (strcmp(cmd, "ajuda") == 0) {
+        mostrarAjudaLote();
+        return 0;
+    }
+    if (strcmp(cmd, "limpar") == 0) {
+        inventarioLimpar(inv);
+        vetorAjustarCapacidade(&inv->itens); /* vazio: devolve a memória dos registros */
+        printf("Inventário vazio.\n");
+        return 0;
+    }
+    if (strcmp(cmd, "carregar") == 0 || strcmp(cmd, "abrir") == 0 || strcmp(cmd, "salvar") == 0) {
+        if (*resto == '\0') {
+            printf("%s: informe o arquivo.\n", cmd);
+            return -1;
+        }
+        if (cmd[0] == 'c') return executarCargaArquivo(inv, resto, 0);
+        return executarArquivoBinario(inv, resto, cmd[0] == 's');
+    }
+    if (strcmp(cmd, "prefixo") == 0) {
+        if (inv->itens.total == 0) {
+            printf("Nenhum componente cadastrado.\n");
+            return -1;
+        }
+        size_t limite = LIMITE_PREFIXO_PADRAO;
+        char *fimNumero;
+        unsigned long long valor = strtoull(resto, &fimNumero, 10);
+        if (fimNumero != resto && isspace((unsigned char)*fimNumero)) { /* "prefixo 50 Pec" */
+            limite = (size_t)valor;
+            resto = fimNumero;
+            while (isspace((unsigned char)*resto)) resto++;
+        }
+        return executarBuscaPrefixo(inv, resto, limite);
+    }
+    if (strcmp(cmd, "conferir") == 0) {
+        if (*resto == '\0') {
+            printf("conferir: informe o arquivo com os nomes.\n");
+            return -1;
+        }
+        if (inv->itens.total == 0) {
+            printf("Nenhum componente cadastrado.\n");
+            return -1;
+        }
+        return executarBuscaLote(inv, resto);
+    }
+    if (strcmp(cmd, "buscar") == 0 || strcmp(cmd, "hash") == 0) {
+        if (inv->itens.total == 0) {
+            printf("Nenhum componente cadastrado.\n");
+            return -1;
+        }
+        return (cmd[0] == 'b') ? executarBuscaBinaria(inv, resto) : executarBuscaHash(inv, resto);
+    }
+    if (strcmp(cmd, "ordenar") == 0) {
+        char *nomeCriterio = proximaPalavra(&resto);
+        if (nomeCriterio && strcmp(nomeCriterio, "composta") == 0) {
+            EspecificacaoOrdenacao esp;
+            if (lerEspecificacaoOrdenacao(resto, &esp) != 0) return -1;
+            if (inv->itens.total == 0) {
+                printf("Nenhum componente cadastrado.\n");
+                return -1;
+            }
+            return executarOrdenacaoComposta(inv, &esp);
+        }
+        char *nomeAlgoritmo = proximaPalavra(&resto);
+        CriterioOrdenacao criterio;
+        if (!nomeCriterio || criterioPorNome(nomeCriterio, &criterio) != 0) {
+            printf("ordenar: critério deve ser nome, tipo ou prioridade.\n");
+            return -1;
+        }
+        if (inv->itens.total == 0) {
+            printf("Nenhum componente cadastrado.\n");
+            return -1;
+        }
+        if (!nomeAlgoritmo || strcmp(nomeAlgoritmo, "visao") == 0) return prepararVisao(inv, criterio);
+
+        for (size_t a = 0; a < sizeof(ALGORITMOS_LOTE) / sizeof(ALGORITMOS_LOTE[0]); ++a) {
+            const AlgoritmoLote *alg = &ALGORITMOS_LOTE[a];
+            if (strcmp(nomeAlgoritmo, alg->nome) != 0 || alg->criterio != criterio) continue;
+            int r;
+            if (criterio == CRITERIO_NOME) {
+                r = ordenarPorNome(&inv->itens, alg->numero);
+                if (r == 0 && inventarioRegistrosOrdenadosPorNome(inv) != 0) inventarioRegistrosMovidos(inv);
+            } else {
+                r = (criterio == CRITERIO_TIPO) ? ordenarPorTipo(&inv->itens, alg->numero)
+                                                : ordenarPorPrioridade(&inv->itens, alg->numero);
+                if (r == 0) inventarioRegistrosMovidos(inv);
+            }
+            return r;
+        }
+        printf("ordenar: algoritmo '%s' não se aplica ao critério %s.\n", nomeAlgoritmo, NOMES_CRITERIO[criterio]);
+        return -1;
+    }
+    if (strcmp(cmd, "mostrar") == 0) {
+        char *nomeCriterio = proximaPalavra(&resto);
+        char *nomeLimite = proximaPalavra(&resto);
+        size_t limite = SIZE_MAX;
+        CriterioOrdenacao criterio;
+        const VisaoIndices *visao = NULL;
+        if (nomeCriterio && strcmp(nomeCriterio, "composta") == 0) {
+            if (!inv->compostaValida) {
+                printf("mostrar: nenhuma visão composta válida (use 'ordenar composta ...').\n");
+                return -1;
+            }
+            visao = &inv->visaoComposta;
+        } else if (nomeCriterio && criterioPorNome(nomeCriterio, &criterio) == 0) {
+            if (!inv->visaoValida[criterio] && prepararVisao(inv, criterio) != 0) return -1;
+            visao = &inv->visoes[criterio];
+        } else if (nomeCriterio) {
+            nomeLimite = nomeCriterio; /* "mostrar 20" */
+        }
+        if (nomeLimite) limite = (size_t)strtoull(nomeLimite, NULL, 10);
+
+        const VetorComponentes *v = &inv->itens;
+        FonteComponentes f = inventarioFonte(inv);
+        if (mostrarCabecalho(v->total) != 0) return 0;
+        size_t n = v->total < limite ? v->total : limite;
+        for (size_t i = 0; i < n; ++i) mostrarLinhaFonte(&f, visao ? visao->indices[i] : (uint32_t)i);
+        if (n < v->total) printf("... (%zu de %zu exibidos)\n", n, v->total);
+        return 0;
+    }
+
+    if (strcmp(cmd, "inserir") == 0) return executarInsercao(inv, resto);
+    if (strcmp(cmd, "topk") == 0) {
+        char *fim;
+        unsigned long long k = strtoull(resto, &fim, 10);
+        if (fim == resto || *fim != '\0' || k < 1) {
+            printf("topk: informe K >= 1.\n");
+            return -1;
+        }
+        if (inv->itens.total == 0) {
+            printf("Nenhum componente cadastrado.\n");
+            return -1;
+        }
+        return executarTopK(inv, (size_t)k);
+    }
+    if (strcmp(cmd, "montar") == 0) {
+        char *acao = proximaPalavra(&resto);
+        if (!acao || strcmp(acao, "iniciar") == 0) return executarIniciarMontagem(inv);
+        if (strcmp(acao, "proximo") == 0) {
+            size_t quantidade = (*resto == '\0') ? 1 : (size_t)strtoull(resto, NULL, 10);
+            return executarRetirarMontagem(inv, quantidade);
+        }
+        if (strcmp(acao, "remover") == 0) return executarAjusteMontagem(inv, resto, 0);
+        if (strcmp(acao, "prioridade") == 0) {
+            char *valor = proximaPalavra(&resto);
+            int prioridade = valor ? atoi(valor) : 0;
+            if (prioridade < PRIORIDADE_MIN || prioridade > PRIORIDADE_MAX || *resto == '\0') {
+                printf("montar prioridade: use 'montar prioridade <%d-%d> <nome>'.\n", PRIORIDADE_MIN, PRIORIDADE_MAX);
+                return -1;
+            }
+            return executarAjusteMontagem(inv, resto, prioridade);
+        }
+        if (strcmp(acao, "estado") == 0) {
+            if (!inv->montagemAtiva) printf("Fila de montagem inativa.\n");
+            else printf("Fila de montagem: %zu componentes.\n", inv->montagem.total);
+            return 0;
+        }
+        printf("montar: use iniciar, proximo [n], remover <nome>, prioridade <p> <nome> ou estado.\n");
+        return -1;
+    }
+    if (strcmp(cmd, "perf") == 0) {
+        if (strcmp(resto, "on") != 0 && strcmp(resto, "off") != 0) {
+            printf("perf: use 'perf on' ou 'perf off'.\n");
+            return -1;
+        }
+        /* indisponibilidade não é erro do script: a execução segue sem contadores */
+        alternarContadoresHw(resto[1] == 'n');
+        return 0;
+    }
+    if (strcmp(cmd, "threads") == 0) {
+        char *fim;
+        long threads = strtol(resto, &fim, 10);
+        if (strcmp(resto, "auto") == 0) {
+            threads = 0;
+        } else if (fim == resto || *fim != '\0' || threads < 1) {
+            printf("threads: use um número >= 1 ou 'auto'.\n");
+            return -1;
+        }
+        definirThreadsOrdenacao((int)(threads > MAX_THREADS ? MAX_THREADS : threads));
+        return 0;
+    }
+    if (strcmp(cmd, "colunas") == 0) {
+        if (strcmp(resto, "on") != 0 && strcmp(resto, "off") != 0) {
+            printf("colunas: use 'colunas on' ou 'colunas off'.\n");
+            return -1;
+        }
+        return executarAlternarColunas(inv, resto[1] == 'n');
+    }
+    if (strcmp(cmd, "medir") == 0) {
+        char *alvo = proximaPalavra(&resto);
+        if (inv->itens.total == 0) {
+            printf("Nenhum componente cadastrado.\n");
+            return -1;
+        }
+        if (alvo && strcmp(alvo, "busca") == 0) {
+            size_t repeticoes = REPETICOES_PADRAO;
+            char *fimNumero;
+            unsigned long long valor = strtoull(resto, &fimNumero, 10);
+            if (fimNumero != resto && isspace((unsigned char)*fimNumero)) {
+                repeticoes = (size_t)valor;
+                resto = fimNumero;
+                while (isspace((unsigned char)*resto)) resto++;
+            }
+            return executarMedicaoBusca(inv, resto, repeticoes);
+        }
+        CriterioOrdenacao criterio;
+        if (!alvo || criterioPorNome(alvo, &criterio) != 0) {
+            printf("medir: use nome, tipo, prioridade ou busca.\n");
+            return -1;
+        }
+        char *nomeAlgoritmo = proximaPalavra(&resto);
+        char *nomeRepeticoes = proximaPalavra(&resto);
+        if (nomeAlgoritmo && isdigit((unsigned char)nomeAlgoritmo[0])) { /* "medir nome 20" */
+            nomeRepeticoes = nomeAlgoritmo;
+            nomeAlgoritmo = NULL;
+        }
+        size_t repeticoes = nomeRepeticoes ? (size_t)strtoull(nomeRepeticoes, NULL, 10) : REPETICOES_PADRAO;
+        return executarMedicaoOrdenacao(inv, criterio, nomeAlgoritmo ? nomeAlgoritmo : "visao", repeticoes);
+    }
+
+    printf("Comando desconhecido: '%s' (use 'ajuda').\n", cmd);
+    return -1;
+}
+
+/*
+ * Executa comandos em lote: de um arquivo (uma linha por comando; "-" = stdin)
+ * ou de uma string com comandos separados por ';'.
+ * Retorna 0 se todos os comandos tiveram sucesso, 1 caso contrário.
+ */
+int executarLote(const char *arquivoScript, const char *comandos) {
+    Inventario inv;
+    inventarioIniciar(&inv);
+    int falhas = 0;
+    int r = 0;
+
+    if (comandos) {
+        char *copia = malloc(strlen(comandos) + 1);
+        if (!copia) return 1;
+        strcpy(copia, comandos);
+        char *p = copia;
+        while (r != 1 && p) {
+            char *sep = strchr(p, ';');
+            if (sep) *sep = '\0';
+            r = executarComando(&inv, p);
+            if (r < 0) falhas++;
+            p = sep ? sep + 1 : NULL;
+        }
+        free(copia);
+    } else {
+        FILE *f = (strcmp(arquivoScript, "-") == 0) ? stdin : fopen(arquivoScript, "r");
+        if (!f) {
+            printf("Não foi possível abrir o script '%s'.\n", arquivoScript);
+            return 1;
+        }
+        char linha[1024];
+        while (r != 1 && fgets(linha, sizeof(linha), f) != NULL) {
+            r = executarComando(&inv, linha);
+            if (r < 0) falhas++;
+        }
+        if (f != stdin) fclose(f);
+    }
+
+    contadoresHwDesligar(&contadoresSessao);
+    inventarioLiberar(&inv);
+    return falhas ? 1 : 0;
+}
+
+/* ---------------- benchmark ---------------- */
+
+typedef enum {
+    DIST_ALEATORIA,
+    DIST_ORDENADA,
+    DIST_INVERSA,
+    DIST_DUPLICADAS,
+    DIST_PRIORIDADE_ENVIESADA,
+    TOTAL_DISTRIBUICOES
+} DistribuicaoBench;
+
+static const char *NOMES_DISTRIBUICAO[TOTAL_DISTRIBUICOES] = {
+    "aleatoria", "ordenada", "inversa", "duplicadas", "prioridade_enviesada"
+};
+
+/* vocabulário de tipos em ordem alfabética (case-insensitive) */
+static const char *TIPOS_BENCH[] = { "controle", "GENERIC", "propulsao", "suporte" };
+#define TOTAL_TIPOS_BENCH (sizeof(TIPOS_BENCH) / sizeof(TIPOS_BENCH[0]))
+
+/* xorshift64*: sequência reprodutível, independente do RAND_MAX da plataforma */
+static uint64_t estadoRngBench = BENCH_SEMENTE;
+
+static uint64_t aleatorioBench(void) {
+    estadoRngBench ^= estadoRngBench >> 12;
+    estadoRngBench ^= estadoRngBench << 25;
+    estadoRngBench ^= estadoRngBench >> 27;
+    return estadoRngBench * 2685821657736338717ULL;
+}
+
+/*
+ * Gera n componentes sintéticos. "ordenada" já está na ordem-alvo de todos os
+ * critérios (nome e tipo crescentes, prioridade decrescente) e "inversa" na
+ * ordem oposta; "duplicadas" usa só 16 nomes distintos.
+ */
+int gerarComponentesBench(VetorComponentes *v, size_t n, DistribuicaoBench dist) {
+    uint32_t idsTipos[TOTAL_TIPOS_BENCH];
+    for (size_t t = 0; t < TOTAL_TIPOS_BENCH; ++t) {
+        idsTipos[t] = tipoInternar(TIPOS_BENCH[t]);
+        if (idsTipos[t] == TIPO_INVALIDO) return -1;
+    }
+    vetorLimpar(v);
+    if (vetorReservar(v, n) != 0) return -1;
+    for (size_t i = 0; i < n; ++i) {
+        Componente *c = vetorAdicionar(v);
+        size_t pos = (dist == DIST_INVERSA) ? n - 1 - i : i;
+        switch (dist) {
+            case DIST_ORDENADA:
+            case DIST_INVERSA:
+                snprintf(c->nome, MAX_NOME, "Peca%010zu", pos);
+                c->tipoId = idsTipos[pos * TOTAL_TIPOS_BENCH / n];
+                c->prioridade = PRIORIDADE_MAX - (int)(pos * (PRIORIDADE_MAX - PRIORIDADE_MIN + 1) / n);
+                break;
+            case DIST_DUPLICADAS:
+                snprintf(c->nome, MAX_NOME, "Peca%02u", (unsigned)(aleatorioBench() % 16));
+                c->tipoId = idsTipos[aleatorioBench() % TOTAL_TIPOS_BENCH];
+                c->prioridade = PRIORIDADE_MIN + (int)(aleatorioBench() % PRIORIDADE_MAX);
+                break;
+            default:
+                snprintf(c->nome, MAX_NOME, "Peca%010llu", (unsigned long long)(aleatorioBench() % 10000000000ULL));
+                c->tipoId = idsTipos[aleatorioBench() % TOTAL_TIPOS_BENCH];
+                if (dist == DIST_PRIORIDADE_ENVIESADA && aleatorioBench() % 10 != 0) c->prioridade = PRIORIDADE_MIN;
+                else c->prioridade = PRIORIDADE_MIN + (int)(aleatorioBench() % PRIORIDADE_MAX);
+                break;
+        }
+        componenteAtualizarChaves(c);
+    }
+    return 0;
+}
+
+/*
+ * Roda todas as ordenações para cada distribuição e cada n = 10, 100, ..., nMax,
+ * 'repeticoes' vezes sobre cópias novas dos dados gerados (medirOrdenacao), e
+ * escreve uma linha CSV por combinação. O progresso vai para stderr. Retorna 0 em sucesso.
+ */
+int executarBenchmark(FILE *saida, size_t nMax, size_t repeticoes) {
+    VetorComponentes base;
+    vetorIniciar(&base);
+    int r = 0;
+
+    fprintf(stderr, "Kernel de chaves: %s\n", kernelChaves.nome);
+    fprintf(saida, "algoritmo,criterio,distribuicao,n,repeticoes,comparacoes,movimentos,"
+                   "tempo_min_s,tempo_mediana_s,tempo_p99_s,tempo_medio_s,ciclos_mediana\n");
+    for (size_t n = 10; n <= nMax && r == 0; n *= 10) {
+        for (int d = 0; d < TOTAL_DISTRIBUICOES && r == 0; ++d) {
+            estadoRngBench = BENCH_SEMENTE;
+            if (gerarComponentesBench(&base, n, (DistribuicaoBench)d) != 0) {
+                fprintf(stderr, "Memória insuficiente para n = %zu.\n", n);
+                r = -1;
+                break;
+            }
+            for (size_t a = 0; a < TOTAL_ALGORITMOS; ++a) {
+                const AlgoritmoOrdenacao *alg = &ALGORITMOS_ORDENACAO[a];
+                if (alg->quadratico && n > BENCH_LIMITE_QUADRATICO) continue;
+
+                EstatisticasTempo est;
+                unsigned long long comps = 0, movs = 0;
+                if (medirOrdenacao(alg, &base, repeticoes, &est, &comps, &movs) != 0) {
+                    fprintf(stderr, "%s: memória insuficiente para n = %zu.\n", alg->nome, n);
+                    continue;
+                }
+                fprintf(saida, "%s,%s,%s,%zu,%zu,%llu,%llu,%.9f,%.9f,%.9f,%.9f,%llu\n", alg->nome,
+                        NOMES_CRITERIO[alg->criterio], NOMES_DISTRIBUICAO[d], n, est.repeticoes, comps, movs,
+                        est.minimo, est.mediana, est.p99, est.media, est.ciclosMediana);
+                fflush(saida);
+                fprintf(stderr, "n = %-9zu %-21s %-10s %-10s mediana %.9f s\n", n, NOMES_DISTRIBUICAO[d], alg->nome,
+                        NOMES_CRITERIO[alg->criterio], est.mediana);
+            }
+        }
+        if (n > SIZE_MAX / 10) break;
+    }
+
+    vetorLiberar(&base);
+    return r;
 }
 
 /* ---------------- ponto de entrada ---------------- */
 
-int main(void) {
+int main(int argc, char *argv[]) {
+    kernelChavesIniciar();
+    if (tiposIniciar() != 0) {
+        printf("Memória insuficiente.\n");
+        return 1;
+    }
     srand((unsigned) time(NULL)); /* semente aleatória (não usada nas ordenações, mas boa prática) */
+    if (argc == 3 && strcmp(argv[1], "-c") == 0) return executarLote(NULL, argv[2]);
+    if (argc == 3 && strcmp(argv[1], "--script") == 0) return executarLote(argv[2], NULL);
+    if (argc >= 2 && argc <= 5 && strcmp(argv[1], "--bench") == 0) {
+        size_t nMax = (argc >= 4) ? (size_t)strtoull(argv[3], NULL, 10) : BENCH_N_MAX_PADRAO;
+        size_t repeticoes = (argc == 5) ? (size_t)strtoull(argv[4], NULL, 10) : 1;
+        FILE *saida = (argc >= 3 && strcmp(argv[2], "-") != 0) ? fopen(argv[2], "w") : stdout;
+        if (!saida) {
+            printf("Não foi possível criar '%s'.\n", argv[2]);
+            return 1;
+        }
+        int r = executarBenchmark(saida, nMax, repeticoes);
+        if (saida != stdout) fclose(saida);
+        return r == 0 ? 0 : 1;
+    }
+    if (argc > 1) {
+        printf("Uso: %s [-c \"cmd; cmd\" | --script arquivo | --bench [saida.csv] [n_max] [repeticoes]]\n", argv[0]);
+        mostrarAjudaLote();
+        return (strcmp(argv[1], "--help") == 0 || strcmp(argv[1], "-h") == 0) ? 0 : 2;
+    }
     menuPrincipal();
     return 0;
 }